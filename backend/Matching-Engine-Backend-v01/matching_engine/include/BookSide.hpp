@@ -0,0 +1,106 @@
+#ifndef BOOK_SIDE_HPP
+#define BOOK_SIDE_HPP
+
+#include <map>
+#include <functional>
+#include "PriceLevel.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BookSide — the set of price levels resting on one side of an OrderBook.
+//
+//  OrderBook only talks to this interface, so the level container is a
+//  selectable implementation (see BookType).  Level addresses handed out by
+//  findOrCreate() stay valid until removeLevel() is called for that price.
+//
+//  "Best" is side-aware: the highest price for BUY, the lowest for SELL.
+// ─────────────────────────────────────────────────────────────────────────────
+enum class BookType {
+    MAP,     // std::map keyed by tick price (original implementation)
+    LADDER   // flat array indexed by tick offset, see PriceLadder.hpp
+};
+
+class BookSide {
+public:
+    explicit BookSide(OrderSide side) : side_(side) {}
+    virtual ~BookSide() = default;
+
+    BookSide(const BookSide&)            = delete;
+    BookSide& operator=(const BookSide&) = delete;
+
+    OrderSide getSide() const { return side_; }
+
+    // Level at `price`, or nullptr when nothing rests there.
+    virtual PriceLevel* find(Price price) = 0;
+
+    // Level at `price`, creating it if needed.
+    virtual PriceLevel& findOrCreate(Price price) = 0;
+
+    // Drop the level at `price`; called once its last order is removed.
+    virtual void removeLevel(Price price) = 0;
+
+    // Best level on this side, or nullptr when the side is empty.
+    virtual PriceLevel* best() = 0;
+
+    virtual bool   empty()      const = 0;
+    virtual size_t levelCount() const = 0;
+
+    // Visit levels from best to worst; stop as soon as `fn` returns false.
+    virtual void forEachLevel(const std::function<bool(const PriceLevel&)>& fn) const = 0;
+
+    // Hint that the market has moved to `reference` ticks.  Containers that
+    // are laid out around a centre price may re-centre; others ignore it.
+    virtual void track(Price /*reference*/) {}
+
+    // True when `a` is a better price than `b` for this side.
+    bool isBetter(Price a, Price b) const {
+        return side_ == OrderSide::BUY ? a > b : a < b;
+    }
+
+protected:
+    OrderSide side_;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapBookSide — ordered tree of levels (one node per occupied price).
+// ─────────────────────────────────────────────────────────────────────────────
+class MapBookSide : public BookSide {
+public:
+    explicit MapBookSide(OrderSide side) : BookSide(side) {}
+
+    PriceLevel* find(Price price) override {
+        auto it = levels_.find(price);
+        return it == levels_.end() ? nullptr : &it->second;
+    }
+
+    PriceLevel& findOrCreate(Price price) override {
+        return levels_.try_emplace(price, price).first->second;
+    }
+
+    void removeLevel(Price price) override {
+        levels_.erase(price);
+    }
+
+    PriceLevel* best() override {
+        if (levels_.empty()) return nullptr;
+        return side_ == OrderSide::BUY ? &levels_.rbegin()->second
+                                       : &levels_.begin()->second;
+    }
+
+    bool   empty()      const override { return levels_.empty(); }
+    size_t levelCount() const override { return levels_.size(); }
+
+    void forEachLevel(const std::function<bool(const PriceLevel&)>& fn) const override {
+        if (side_ == OrderSide::BUY) {
+            for (auto it = levels_.rbegin(); it != levels_.rend(); ++it)
+                if (!fn(it->second)) return;
+        } else {
+            for (auto it = levels_.begin(); it != levels_.end(); ++it)
+                if (!fn(it->second)) return;
+        }
+    }
+
+private:
+    std::map<Price, PriceLevel> levels_;
+};
+
+#endif // BOOK_SIDE_HPP
@@ -0,0 +1,90 @@
+#ifndef BOOK_SNAPSHOT_HPP
+#define BOOK_SNAPSHOT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "Instrument.hpp"
+
+// Levels per side carried in a published depth snapshot.
+static constexpr size_t BOOK_SNAPSHOT_DEPTH = 10;
+
+// One aggregated price level as seen by readers (price in ticks).
+struct DepthLevel {
+    Price  price;
+    size_t quantity;
+    size_t orderCount;
+};
+
+// Best bid / ask in ticks with the quantity resting there (0 when empty).
+struct TopOfBook {
+    Price  bidPrice    = 0;
+    size_t bidQuantity = 0;
+    Price  askPrice    = 0;
+    size_t askQuantity = 0;
+};
+
+// Top BOOK_SNAPSHOT_DEPTH levels per side, best first.
+struct BookSnapshot {
+    uint64_t version      = 0;  // bumped on every publication
+    uint64_t feedSequence = 0;  // last MarketDataEvent reflected here
+    size_t   bidCount     = 0;
+    size_t   askCount     = 0;
+    std::array<DepthLevel, BOOK_SNAPSHOT_DEPTH> bids{};
+    std::array<DepthLevel, BOOK_SNAPSHOT_DEPTH> asks{};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Seqlock — single-writer, many-reader publication of a small POD value.
+//
+//  The writer makes the sequence odd, rewrites the payload and makes it even
+//  again; a reader copies the payload between two reads of the sequence and
+//  retries if they differ or were odd.  Readers never block the writer and
+//  never take a lock.  The payload is held as relaxed atomic words so the
+//  racing copy is well-defined.  store() must only ever be called by one
+//  thread at a time (OrderBook calls it under its mutex).
+// ─────────────────────────────────────────────────────────────────────────────
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    Seqlock() { store(T{}); }
+
+    Seqlock(const Seqlock&)            = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) words_[i].store(buffer[i], std::memory_order_relaxed);
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        uint64_t buffer[WORDS];
+        for (;;) {
+            const uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) continue;                   // write in progress
+            for (size_t i = 0; i < WORDS; ++i) buffer[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t>             words_[WORDS];
+};
+
+#endif // BOOK_SNAPSHOT_HPP
@@ -0,0 +1,80 @@
+#ifndef DEPTH_CACHE_HPP
+#define DEPTH_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include "BookSide.hpp"
+#include "BookSnapshot.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DepthCache — the best BOOK_SNAPSHOT_DEPTH levels of one book side,
+//  aggregated (market-by-price) and kept up to date in place.
+//
+//  The book reports every level whose quantity or order count changed
+//  (update()) and every level it drops (remove()).  Invariant: the array
+//  holds exactly the best min(BOOK_SNAPSHOT_DEPTH, levelCount) non-empty
+//  levels, best first — so a level that is not cached while the array is
+//  full is worse than all cached ones, and a short array means the whole
+//  side is cached.  Only dropping a cached level from a full array needs to
+//  look at the side again, and then only at its first N levels.
+//
+//  Used under the owning OrderBook's mutex.
+// ─────────────────────────────────────────────────────────────────────────────
+class DepthCache {
+public:
+    explicit DepthCache(OrderSide side) : side_(side) {}
+
+    void update(const PriceLevel& level) {
+        const Price price = level.getPrice();
+        size_t i = 0;
+        while (i < count_ && isBetter(levels_[i].price, price)) ++i;
+        if (i < count_ && levels_[i].price == price) {
+            levels_[i].quantity   = level.getTotalQuantity();
+            levels_[i].orderCount = level.getOrderCount();
+            return;
+        }
+        if (level.isEmpty() || i == BOOK_SNAPSHOT_DEPTH) return;   // outside the top N
+        const size_t last = std::min(count_, BOOK_SNAPSHOT_DEPTH - 1);
+        std::move_backward(levels_.begin() + i, levels_.begin() + last, levels_.begin() + last + 1);
+        levels_[i] = DepthLevel{price, level.getTotalQuantity(), level.getOrderCount()};
+        if (count_ < BOOK_SNAPSHOT_DEPTH) ++count_;
+    }
+
+    // Call after `side` has dropped the level at `price`.
+    void remove(Price price, const BookSide& side) {
+        size_t i = 0;
+        while (i < count_ && levels_[i].price != price) ++i;
+        if (i == count_) return;
+        if (count_ < BOOK_SNAPSHOT_DEPTH) {
+            std::move(levels_.begin() + i + 1, levels_.begin() + count_, levels_.begin() + i);
+            --count_;
+            return;
+        }
+        rebuild(side);   // the next level down may be uncached
+    }
+
+    void rebuild(const BookSide& side) {
+        count_ = 0;
+        side.forEachLevel([&](const PriceLevel& level) {
+            if (!level.isEmpty())
+                levels_[count_++] = DepthLevel{level.getPrice(), level.getTotalQuantity(),
+                                               level.getOrderCount()};
+            return count_ < BOOK_SNAPSHOT_DEPTH;
+        });
+    }
+
+    size_t size() const { return count_; }
+    const std::array<DepthLevel, BOOK_SNAPSHOT_DEPTH>& levels() const { return levels_; }
+
+private:
+    bool isBetter(Price a, Price b) const {
+        return side_ == OrderSide::BUY ? a > b : a < b;
+    }
+
+    OrderSide                                   side_;
+    size_t                                      count_ = 0;
+    std::array<DepthLevel, BOOK_SNAPSHOT_DEPTH> levels_{};
+};
+
+#endif // DEPTH_CACHE_HPP
@@ -3,15 +3,53 @@
 
 #include <string>
 #include <vector>
+#include <cmath>
+#include <cstdint>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Price — an integer number of ticks.
+//
+//  Every price inside the matching engine (Order, Trade, PriceLevel and the
+//  OrderBook level maps) is held as a 64-bit tick count so level membership
+//  and price comparisons are exact.  Doubles only appear at the edges: user
+//  input, the ILP rows written by Logger and the JSON served on port 9100.
+//  Use Instrument::toTicks() / Instrument::toPrice() to cross that boundary.
+// ─────────────────────────────────────────────────────────────────────────────
+using Price = int64_t;
+
+// Resting orders without their own expiry (anything but GTT) expire this many
+// seconds after placement unless the instrument overrides it.
+static constexpr int ORDER_EXPIRY_SECONDS = 5;
 
 struct Instrument {
     std::string name;
     std::string symbol;
     int instrumentId;
     double marketPrice;
+    double tickSize;   // minimum price increment (rupees per tick)
+    size_t lotSize;    // minimum tradable quantity (shares per lot)
+    int orderExpirySeconds = ORDER_EXPIRY_SECONDS; // default resting lifetime
+
+    Instrument(const std::string& n, const std::string& s, int id, double mPrice,
+               double tick = 0.05, size_t lot = 1)
+        : name(n), symbol(s), instrumentId(id), marketPrice(mPrice)
+        , tickSize(tick), lotSize(lot) {}
 
-    Instrument(const std::string& n, const std::string& s, int id, double mPrice)
-        : name(n), symbol(s), instrumentId(id), marketPrice(mPrice) {}
+    // Snap a rupee price to the nearest tick.
+    Price toTicks(double price) const {
+        return static_cast<Price>(std::llround(price / tickSize));
+    }
+
+    // Render a tick count back to rupees (ILP / JSON / terminal output only).
+    double toPrice(Price ticks) const {
+        return static_cast<double>(ticks) * tickSize;
+    }
+
+    // Round a share quantity down to a whole number of lots (minimum one lot).
+    size_t roundToLot(size_t quantity) const {
+        size_t lots = quantity / lotSize;
+        return (lots == 0 ? 1 : lots) * lotSize;
+    }
 };
 
 class InstrumentManager {
@@ -24,6 +62,12 @@ public:
     const std::vector<Instrument>& getInstruments() const { return instruments_; }
 
     const Instrument* getInstrumentById(int id) const {
+        // Instruments are registered with contiguous IDs starting at 1, so the
+        // direct slot is checked first; the scan is only a fallback.
+        if (id >= 1 && static_cast<size_t>(id) <= instruments_.size() &&
+            instruments_[id - 1].instrumentId == id) {
+            return &instruments_[id - 1];
+        }
         for (const auto& instrument : instruments_) {
             if (instrument.instrumentId == id) {
                 return &instrument;
@@ -32,9 +76,15 @@ public:
         return nullptr;
     }
 
+    // Tick → rupee conversion for callers that only carry an instrument ID.
+    double toPrice(int instrumentId, Price ticks) const {
+        const Instrument* instrument = getInstrumentById(instrumentId);
+        return instrument ? instrument->toPrice(ticks) : static_cast<double>(ticks);
+    }
+
 private:
     InstrumentManager() {
-        // Initialize with instruments and their market prices
+        // Initialize with instruments, their market prices and tick sizes
         instruments_ = {
             Instrument("Reliance Industries", "RELIANCE (NSE)", 1, 1577.0),
             Instrument("Tata Consultancy Services", "TCS (NSE)", 2, 3213.0),
@@ -49,7 +99,7 @@ private:
             Instrument("Nifty 50 Index", "NIFTY 50", 11, 26250.3),
             Instrument("Bank Nifty Index", "BANKNIFTY", 12, 60044.2),
             Instrument("FinNifty", "FINNIFTY", 13, 27851.45),
-            Instrument("Sensex", "SENSEX", 14, 84961.14), // No price provided
+            Instrument("Sensex", "SENSEX", 14, 84961.14, 0.01), // BSE quotes to the paisa
             Instrument("Nifty Next 50 Index", "NIFTY NEXT 50", 15, 70413.4)
         };
     }
@@ -57,4 +107,4 @@ private:
     std::vector<Instrument> instruments_;
 };
 
-#endif // INSTRUMENT_HPP
\ No newline at end of file
+#endif // INSTRUMENT_HPP
@@ -46,19 +46,19 @@
  *  SYMBOL (indexed tag) columns — appear before the space in ILP lines:
  *  ─────────────────────────────────────────────────────────────────────────
  *  order_id              SYMBOL   unique order identifier
- *                                 (format: instrId-random10-traderId)
+ *                                 (format: <instrumentId>-<sequence>)
  *                                 "NA" for TRADE_MATCH rows
  *  instrument_id         SYMBOL   numeric instrument ID (1–15)
- *  order_type            SYMBOL   LIMIT | MARKET | MATCH
+ *  order_type            SYMBOL   LIMIT | MARKET | STOP | STOP_LIMIT | MATCH
  *  side                  SYMBOL   BUY | SELL
  *  order_status_event    SYMBOL   ORDER_NEW | ORDER_PARTIAL | ORDER_FILLED |
  *                                 ORDER_CANCELLED | ORDER_EXPIRED |
- *                                 TRADE_MATCH
+ *                                 ORDER_AMENDED | STOP_TRIGGERED | TRADE_MATCH
  *  user_id               SYMBOL   traderId of the submitting user
  *                                 (matches users.id for real users,
  *                                  0-9999 for mock traders)
  *                                 "NA" for TRADE_MATCH rows
- *  trade_id              SYMBOL   unique trade ID (TRD-instrId-random10)
+ *  trade_id              SYMBOL   unique trade ID (TRD-<instrumentId>-<sequence>)
  *                                 "NA" for non-match order events
  *  buyer_user_id         SYMBOL   traderId of the buy-side participant
  *                                 "NA" for non-match order events
@@ -75,7 +75,9 @@
  *  FIELD (typed value) columns — appear after the space in ILP lines:
  *  ─────────────────────────────────────────────────────────────────────────
  *  price                 DOUBLE   limit price (or 0.0 for MARKET orders)
- *  quantity              LONG     original order quantity
+ *  stop_price            DOUBLE   trigger price of STOP / STOP_LIMIT orders
+ *                                 (0.0 for every other order type)
+ *  quantity              LONG     order quantity (as amended)
  *  filled_quantity       LONG     shares filled so far
  *  remaining_quantity    LONG     shares still pending (quantity - filled)
  *  is_short_sell         BOOLEAN  true if this is a short-sell order
@@ -140,35 +142,46 @@ public:
     //  Trade-specific columns (trade_id, buyer_user_id, seller_user_id,
     //  aggressor_side) are set to "NA" — they are only meaningful in
     //  TRADE_MATCH rows written by logTrade().
+    //
+    //  `event` overrides the status-derived order_status_event (the book
+    //  passes "ORDER_AMENDED" for amends).
     // ══════════════════════════════════════════════════════════════════════════
-    void logOrder(const Order& order) {
-        const std::string ordType   = (order.getType() == OrderType::LIMIT) ? "LIMIT" : "MARKET";
+    void logOrder(const Order& order, const OrderDetails& details, const char* event = nullptr) {
+        std::ostringstream ilp;
+        appendOrder(ilp, order, details, event);
+        send(ilp.str());
+    }
+
+    // Format the logOrder() row into `ilp` without sending it (see send()).
+    void appendOrder(std::ostream& ilp, const Order& order, const OrderDetails& details,
+                     const char* event = nullptr) const {
+        const std::string ordType   = orderTypeName(order.getType());
         const std::string side      = (order.getSide() == OrderSide::BUY)   ? "BUY"   : "SELL";
-        const std::string statusEvt = orderStatusEventStr(order.getStatus());
+        const std::string statusEvt = event ? event : orderStatusEventStr(order.getStatus());
         const std::string instrId   = std::to_string(order.getInstrumentId());
-        const std::string orderId   = sanitizeTag(order.getOrderId());
-        const std::string userId    = sanitizeTag(order.getTraderId());
-        const std::string phase     = sanitizeTag(order.getMarketPhase());
-        const std::string devHash   = sanitizeTag(order.getDeviceIdHash());
+        const std::string orderId   = formatOrderId(order.getOrderId());
+        const TraderRegistry& traders = TraderRegistry::getInstance();
+        const std::string& userId   = traders.tag(order.getTrader());
+        const std::string phase     = sanitizeTag(details.getMarketPhase());
+        const std::string& devHash  = traders.deviceHash(order.getTrader());
 
-        const long long qty          = static_cast<long long>(order.getQuantity());
+        const long long qty          = static_cast<long long>(details.getQuantity());
         const long long filledQty    = static_cast<long long>(
-                                           order.getQuantity() - order.getRemainingQuantity());
+                                           details.getQuantity() - order.getRemainingQuantity());
         const long long remainingQty = static_cast<long long>(order.getRemainingQuantity());
         const bool      shortSell    = order.isShortSell();
 
         // All timestamps in microseconds (as requested) — ILP designated
         // timestamp at the end uses nanoseconds (QuestDB native precision).
-        const long long submitMicros  = toMicros(order.getSubmitTimestamp());
-        const long long cancelMicros  = isCancelledOrExpiredWithStamp(order)
-                                            ? toMicros(order.getCancelTimestamp()) : 0LL;
+        const long long submitMicros  = toMicros(details.getSubmitTimestamp());
+        const long long cancelMicros  = isCancelledOrExpiredWithStamp(order, details)
+                                            ? toMicros(details.getCancelTimestamp()) : 0LL;
         const long long matchMicros   = toMicros(std::chrono::system_clock::now());
-        const long long tsNanos       = toNanos(order.getSubmitTimestamp());
+        const long long tsNanos       = toNanos(details.getSubmitTimestamp());
 
         // ── ILP line ──────────────────────────────────────────────────────────
         // Tags  : all SYMBOL columns  (comma-separated before the space)
         // Fields: all typed columns   (comma-separated after the space)
-        std::ostringstream ilp;
         ilp << "trade_logs"
             // ── tag section ────────────────────────────────────────────────
             << ",order_id="           << orderId
@@ -180,16 +193,19 @@ public:
             // trade_id / buyer_user_id / seller_user_id are "NA" for orders
             // that were never matched; for matched orders (PARTIAL / FILLED /
             // CANCELLED-after-partial / EXPIRED-after-partial) they carry the
-            // real IDs embedded by OrderBook::executeTrade() via fillWithTradeContext().
-            << ",trade_id="           << sanitizeTag(order.getMatchedTradeId())
-            << ",buyer_user_id="      << sanitizeTag(order.getCounterpartyBuyerUid())
-            << ",seller_user_id="     << sanitizeTag(order.getCounterpartySellerUid())
+            // real IDs embedded by OrderBook::executeTrade() via OrderDetails::setTradeContext().
+            << ",trade_id="           << sanitizeTag(details.getMatchedTradeId(order.getInstrumentId()))
+            << ",buyer_user_id="      << traders.tagOrNA(details.getCounterpartyBuyer())
+            << ",seller_user_id="     << traders.tagOrNA(details.getCounterpartySeller())
             << ",aggressor_side=NA"              // NA for non-match order events
             << ",market_phase="       << phase
             << ",device_id_hash="     << devHash
             // ── field section ──────────────────────────────────────────────
             << " "
             << "price="                     << std::fixed << order.getPrice()
+            << ",stop_price="               << std::fixed
+                                            << InstrumentManager::getInstance().toPrice(
+                                                   order.getInstrumentId(), details.getStopPrice())
             << ",quantity="                 << qty          << "i"
             << ",filled_quantity="          << filledQty    << "i"
             << ",remaining_quantity="       << remainingQty << "i"
@@ -199,9 +215,6 @@ public:
             << ",match_engine_timestamp="   << matchMicros  << "i"
             // ── designated timestamp (nanos) ───────────────────────────────
             << " " << tsNanos << "\n";
-
-        std::lock_guard<std::mutex> lock(mutex_);
-        sendILP(ilp.str());
     }
 
     // ══════════════════════════════════════════════════════════════════════════
@@ -221,11 +234,19 @@ public:
     //  device_id_hash) because the match involves TWO orders / users.
     // ══════════════════════════════════════════════════════════════════════════
     void logTrade(const Trade& trade) {
+        std::ostringstream ilp;
+        appendTrade(ilp, trade);
+        send(ilp.str());
+    }
+
+    // Format the logTrade() row into `ilp` without sending it (see send()).
+    void appendTrade(std::ostream& ilp, const Trade& trade) const {
         const std::string instrId      = std::to_string(trade.getInstrumentId());
         const std::string tradeId      = sanitizeTag(trade.getTradeId());
-        const std::string buyOrderId   = sanitizeTag(trade.getBuyOrderId());
-        const std::string buyerUid     = sanitizeTag(trade.getBuyerUserId());
-        const std::string sellerUid    = sanitizeTag(trade.getSellerUserId());
+        const std::string buyOrderId   = formatOrderId(trade.getBuyOrderId());
+        const TraderRegistry& traders  = TraderRegistry::getInstance();
+        const std::string& buyerUid    = traders.tag(trade.getBuyer());
+        const std::string& sellerUid   = traders.tag(trade.getSeller());
         const std::string aggrSide     = (trade.getAggressorSide() == OrderSide::BUY)
                                              ? "BUY" : "SELL";
         const std::string phase        = sanitizeTag(marketPhaseFromTp(trade.getTimestamp()));
@@ -234,17 +255,16 @@ public:
         // use the aggressor's user ID (the party that crossed the spread and
         // triggered the match), exactly as we would use their device fingerprint
         // in a production surveillance system.
-        const std::string& aggrUserId  = (trade.getAggressorSide() == OrderSide::BUY)
-                                             ? trade.getBuyerUserId()
-                                             : trade.getSellerUserId();
-        const std::string devHash      = sanitizeTag(Order::computeDeviceIdHash(aggrUserId));
+        const TraderIndex  aggressor   = (trade.getAggressorSide() == OrderSide::BUY)
+                                             ? trade.getBuyer()
+                                             : trade.getSeller();
+        const std::string& devHash     = traders.deviceHash(aggressor);
 
         const long long   qty          = static_cast<long long>(trade.getQuantity());
         const long long   matchMicros  = toMicros(std::chrono::system_clock::now());
         const long long   submitMicros = toMicros(trade.getTimestamp());
         const long long   tsNanos      = toNanos(trade.getTimestamp());
 
-        std::ostringstream ilp;
         ilp << "trade_logs"
             // ── tag section ────────────────────────────────────────────────
             << ",order_id="           << buyOrderId
@@ -271,9 +291,14 @@ public:
             << ",match_engine_timestamp="   << matchMicros  << "i"
             // ── designated timestamp (nanos) ───────────────────────────────
             << " " << tsNanos << "\n";
+    }
 
+    // Hand any number of rows built with appendOrder()/appendTrade() to
+    // QuestDB in one write — one lock acquisition for a whole batch.
+    void send(const std::string& rows) {
+        if (rows.empty()) return;
         std::lock_guard<std::mutex> lock(mutex_);
-        sendILP(ilp.str());
+        sendILP(rows);
     }
 
 private:
@@ -334,9 +359,9 @@ private:
     }
 
     // Returns true only for CANCELLED orders that have a valid cancel stamp.
-    static bool isCancelledOrExpiredWithStamp(const Order& order) {
+    static bool isCancelledOrExpiredWithStamp(const Order& order, const OrderDetails& details) {
         return order.getStatus() == OrderStatus::CANCELLED &&
-               order.getCancelTimestamp().time_since_epoch().count() != 0;
+               details.getCancelTimestamp().time_since_epoch().count() != 0;
     }
 
     // ── Market-phase classification (mirrors Order::computeMarketPhase) ───────
@@ -360,11 +385,7 @@ private:
 
     // Replace ILP tag-special characters (space, comma, equals) with underscore.
     static std::string sanitizeTag(const std::string& val) {
-        std::string out = val;
-        for (char& c : out) {
-            if (c == ' ' || c == ',' || c == '=') c = '_';
-        }
-        return out;
+        return sanitizeIlpTag(val);
     }
 
     // sendHttpQuery — for one-off administrative SQL (not on hot path).
@@ -0,0 +1,109 @@
+#ifndef MARKET_DATA_FEED_HPP
+#define MARKET_DATA_FEED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "Order.hpp"
+
+// Events retained per book for /feed consumers that fall behind (power of two).
+static constexpr size_t MARKET_DATA_JOURNAL_SIZE = size_t(1) << 14;
+
+// Most events returned by one GET /feed or /l3 request; clients page with ?since=.
+static constexpr size_t MARKET_DATA_FEED_PAGE = 2000;
+
+// Order-by-order (L3) events cost one journal entry per order action; turn
+// them off here if nobody consumes them.
+static constexpr bool MARKET_DATA_L3_ENABLED = true;
+
+// One incremental market-data event.  A book publishes two streams, each
+// with its own sequence (per book, from 1, no gaps):
+//
+//   L2  LEVEL / TRADE — aggregated depth; applying them in order yields
+//       exactly the book's levels.
+//   L3  ORDER_ADD / ORDER_EXECUTE / ORDER_AMEND / ORDER_DELETE — every
+//       resting order's life, keyed by OrderId, in queue-priority order
+//       within a level.  An order executed down to zero leaves the book
+//       without an ORDER_DELETE.  ORDER_AMEND gives the order's new price
+//       and open quantity: it keeps its place only if the price is unchanged
+//       and the quantity went down, otherwise it is now last at its price;
+//       quantity 0 means it traded away in full at the new price.
+struct MarketDataEvent {
+    enum Kind : uint8_t {
+        LEVEL,          // a level's aggregate changed; quantity 0 = level removed
+        TRADE,          // a match printed
+        ORDER_ADD,      // an order joined the back of its level
+        ORDER_EXECUTE,  // a resting order traded `quantity`
+        ORDER_DELETE,   // a resting order was cancelled or expired
+        ORDER_AMEND     // a resting order was re-priced / re-sized
+    };
+
+    Kind      kind;
+    OrderSide side;            // book side, except TRADE: aggressor side
+    int       instrumentId;
+    uint64_t  sequence;
+    Price     price;           // ticks
+    size_t    quantity;        // LEVEL: new total; TRADE, ORDER_EXECUTE: traded;
+                               // ORDER_ADD, ORDER_AMEND: resting; ORDER_DELETE: unfilled
+    size_t    orderCount;      // LEVEL only
+    uint64_t  tradeSequence;   // TRADE, ORDER_EXECUTE
+    OrderId   orderId;         // ORDER_* only
+};
+
+// Every resting order as an ORDER_ADD event (best level first, queue order
+// within a level), as of L3 sequence `sequence`.
+struct OrderBookImage {
+    uint64_t                     sequence = 0;
+    std::vector<MarketDataEvent> orders;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MarketDataJournal — the last MARKET_DATA_JOURNAL_SIZE events of one
+//  book's L2 or L3 stream.
+//
+//  The book appends each batch's events once, when it publishes its depth
+//  snapshot, so the journal mutex is taken once per batch rather than per
+//  event and never while readers hold the book mutex.  Readers ask for
+//  everything after the last sequence they applied; if that has already been
+//  overwritten they must resynchronise from a snapshot (BookSnapshot for L2,
+//  OrderBookImage for L3), which says which sequence it reflects.
+// ─────────────────────────────────────────────────────────────────────────────
+class MarketDataJournal {
+public:
+    MarketDataJournal() : events_(MARKET_DATA_JOURNAL_SIZE) {}
+
+    MarketDataJournal(const MarketDataJournal&)            = delete;
+    MarketDataJournal& operator=(const MarketDataJournal&) = delete;
+
+    // Events must carry consecutive sequences following lastSequence().
+    void append(const std::vector<MarketDataEvent>& batch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const MarketDataEvent& event : batch)
+            events_[event.sequence & (MARKET_DATA_JOURNAL_SIZE - 1)] = event;
+        if (!batch.empty()) last_ = batch.back().sequence;
+    }
+
+    // Copy up to `max` events with sequence > `after` into `out`.  Returns
+    // false (and copies nothing) if some of them are no longer retained.
+    bool readSince(uint64_t after, std::vector<MarketDataEvent>& out, size_t max) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (after > last_) return true;
+        if (last_ - after > MARKET_DATA_JOURNAL_SIZE) return false;
+        for (uint64_t seq = after + 1; seq <= last_ && out.size() < max; ++seq)
+            out.push_back(events_[seq & (MARKET_DATA_JOURNAL_SIZE - 1)]);
+        return true;
+    }
+
+    uint64_t lastSequence() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_;
+    }
+
+private:
+    mutable std::mutex           mutex_;
+    std::vector<MarketDataEvent> events_;
+    uint64_t                     last_ = 0;
+};
+
+#endif // MARKET_DATA_FEED_HPP
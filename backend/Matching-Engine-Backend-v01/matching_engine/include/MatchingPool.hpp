@@ -0,0 +1,269 @@
+#ifndef MATCHING_POOL_HPP
+#define MATCHING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "OrderBook.hpp"
+#include "TimerService.hpp"
+#include "ThreadTuning.hpp"
+
+// Rebalance period in TimerService ticks (10 × 100 ms = 1 s).
+static constexpr unsigned POOL_REBALANCE_TICKS = 10;
+
+// A book migrates only if the busiest worker ran at least this many more
+// commands than the idlest one over the last period, and that gap is at
+// least a quarter of the busiest worker's load.
+static constexpr uint64_t POOL_REBALANCE_MIN_GAP = 1000;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MatchingPool — N matching workers shared by many POOLED OrderBooks.
+//
+//  Each book is owned by exactly one worker at a time.  A worker polls its
+//  books round-robin (OrderBook::pollCommands(): at most one command batch
+//  per book per round, so a hot book cannot starve its neighbours) and, once
+//  none of them has work, spins or parks per ThreadTuning's wait strategy;
+//  producers and the TimerService wake the owning worker only.
+//
+//  Load balancing: every POOL_REBALANCE_TICKS the pool samples each book's
+//  executed-command counter, sums the rates per worker, and moves at most one
+//  book from the busiest to the idlest worker — the one whose rate best
+//  halves the gap.  A single hot book on its own worker is never moved, as
+//  that would not help.  Ownership changes hands only at a quiescent point:
+//  the old owner drops the book between rounds and posts it to the new
+//  owner's inbox, so no two workers ever poll the same book.
+//
+//  Books attach after construction and detach themselves in their destructor,
+//  so destroy every book before the pool.
+// ─────────────────────────────────────────────────────────────────────────────
+class MatchingPool : public BookScheduler, private TimerClient {
+public:
+    static unsigned defaultWorkerCount() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    explicit MatchingPool(unsigned workerCount = defaultWorkerCount())
+        : running_(true)
+    {
+        workers_.reserve(std::max(1u, workerCount));
+        for (unsigned i = 0; i < std::max(1u, workerCount); ++i)
+            workers_.emplace_back(new Worker());
+        for (unsigned i = 0; i < workers_.size(); ++i)
+            workers_[i]->thread = std::thread([this, i]() { runWorker(*workers_[i]); });
+        TimerService::getInstance().subscribe(this);
+    }
+
+    ~MatchingPool() {
+        TimerService::getInstance().unsubscribe(this);
+        running_.store(false);
+        for (auto& w : workers_) {
+            wake(*w);
+            w->thread.join();
+        }
+    }
+
+    MatchingPool(const MatchingPool&)            = delete;
+    MatchingPool& operator=(const MatchingPool&) = delete;
+
+    size_t workerCount() const { return workers_.size(); }
+
+    // Hand a POOLED book to the least-loaded worker.
+    void attach(OrderBook& book) {
+        std::lock_guard<std::mutex> lock(assignMutex_);
+        std::vector<uint64_t> load(workers_.size(), 0);
+        std::vector<size_t>   books(workers_.size(), 0);
+        for (const Assignment& a : assignments_) {
+            load[a.worker]  += a.rate;
+            books[a.worker] += 1;
+        }
+        unsigned target = 0;
+        for (unsigned w = 1; w < workers_.size(); ++w)
+            if (load[w] < load[target] || (load[w] == load[target] && books[w] < books[target]))
+                target = w;
+
+        book.scheduler_ = this;
+        book.ownerWorker_.store(target);
+        assignments_.push_back(Assignment{&book, target, book.commandsExecuted_.load(), 0, true});
+        post(target, Op{Op::ADOPT, &book, target, nullptr});
+    }
+
+    void wakeOwner(OrderBook& book) override {
+        Worker& w = *workers_[book.ownerWorker_.load(std::memory_order_relaxed)];
+        if (w.parked.load(std::memory_order_relaxed)) wake(w);
+    }
+
+    void detach(OrderBook& book) override {
+        unsigned owner;
+        {
+            std::unique_lock<std::mutex> lock(assignMutex_);
+            auto it = findAssignment(book);
+            if (it == assignments_.end()) return;
+            migrateCv_.wait(lock, [&]() { return !findAssignment(book)->migrating; });
+            it    = findAssignment(book);
+            owner = it->worker;
+            assignments_.erase(it);
+        }
+        auto done = std::make_shared<std::promise<void>>();
+        std::future<void> detached = done->get_future();
+        post(owner, Op{Op::DETACH, &book, owner, done});
+        detached.wait();
+        book.scheduler_ = nullptr;
+    }
+
+private:
+    struct Op {
+        enum Kind { ADOPT, RELEASE, DETACH } kind;
+        OrderBook*                          book;
+        unsigned                            dest;   // RELEASE: new owner
+        std::shared_ptr<std::promise<void>> done;   // DETACH
+    };
+
+    struct Worker {
+        std::thread             thread;
+        std::vector<OrderBook*> books;              // owned by this worker's thread
+        std::mutex              inboxMutex;
+        std::vector<Op>         inbox;
+        std::vector<Op>         ops;                // inbox being applied
+        std::atomic<bool>       parked{false};
+        std::mutex              parkMutex;
+        std::condition_variable parkCv;
+    };
+
+    struct Assignment {
+        OrderBook* book;
+        unsigned   worker;
+        uint64_t   lastCount;   // commandsExecuted_ at the last sample
+        uint64_t   rate;        // commands over the last period
+        bool       migrating;   // ADOPT posted, not yet applied
+    };
+
+    std::vector<Assignment>::iterator findAssignment(OrderBook& book) {
+        return std::find_if(assignments_.begin(), assignments_.end(),
+                            [&](const Assignment& a) { return a.book == &book; });
+    }
+
+    void post(unsigned worker, Op op) {
+        Worker& w = *workers_[worker];
+        {
+            std::lock_guard<std::mutex> lock(w.inboxMutex);
+            w.inbox.push_back(std::move(op));
+        }
+        wake(w);
+    }
+
+    void wake(Worker& w) {
+        std::lock_guard<std::mutex> lock(w.parkMutex);
+        w.parkCv.notify_one();
+    }
+
+    // Runs between rounds, i.e. while none of this worker's books is mid-batch.
+    void applyInbox(Worker& w) {
+        {
+            std::lock_guard<std::mutex> lock(w.inboxMutex);
+            if (w.inbox.empty()) return;
+            w.ops.swap(w.inbox);
+        }
+        for (Op& op : w.ops) {
+            switch (op.kind) {
+                case Op::ADOPT: {
+                    w.books.push_back(op.book);
+                    std::lock_guard<std::mutex> lock(assignMutex_);
+                    auto it = findAssignment(*op.book);
+                    if (it != assignments_.end()) it->migrating = false;
+                    migrateCv_.notify_all();
+                    break;
+                }
+                case Op::RELEASE:
+                    w.books.erase(std::remove(w.books.begin(), w.books.end(), op.book), w.books.end());
+                    op.book->ownerWorker_.store(op.dest);
+                    post(op.dest, Op{Op::ADOPT, op.book, op.dest, nullptr});
+                    break;
+                case Op::DETACH:
+                    w.books.erase(std::remove(w.books.begin(), w.books.end(), op.book), w.books.end());
+                    op.done->set_value();
+                    break;
+            }
+        }
+        w.ops.clear();
+    }
+
+    void runWorker(Worker& w) {
+        ThreadTuning& tuning = ThreadTuning::getInstance();
+        tuning.pin(ThreadRole::MATCHING);
+        unsigned idlePolls = 0;
+        while (running_.load()) {
+            applyInbox(w);
+            bool busy = false;
+            for (OrderBook* book : w.books) busy |= book->pollCommands();
+            if (busy) { idlePolls = 0; continue; }
+            if (tuning.keepSpinning(idlePolls++)) { cpuRelax(); continue; }
+
+            std::unique_lock<std::mutex> lock(w.parkMutex);
+            w.parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool idle = running_.load();
+            for (OrderBook* book : w.books) idle = idle && !book->hasPendingWork();
+            if (idle) {
+                std::lock_guard<std::mutex> inboxLock(w.inboxMutex);
+                idle = w.inbox.empty();
+            }
+            if (idle) w.parkCv.wait_for(lock, std::chrono::milliseconds(TIMER_WHEEL_TICK_MS));
+            w.parked.store(false, std::memory_order_relaxed);
+            idlePolls = 0;
+        }
+    }
+
+    void onTimerTick(uint64_t) override {
+        if (++ticksSinceRebalance_ < POOL_REBALANCE_TICKS) return;
+        ticksSinceRebalance_ = 0;
+        rebalance();
+    }
+
+    void rebalance() {
+        std::lock_guard<std::mutex> lock(assignMutex_);
+        std::vector<uint64_t> load(workers_.size(), 0);
+        for (Assignment& a : assignments_) {
+            const uint64_t count = a.book->commandsExecuted_.load(std::memory_order_relaxed);
+            a.rate      = count - a.lastCount;
+            a.lastCount = count;
+            load[a.worker] += a.rate;
+        }
+        unsigned hot = 0, cold = 0;
+        for (unsigned w = 1; w < workers_.size(); ++w) {
+            if (load[w] > load[hot])  hot  = w;
+            if (load[w] < load[cold]) cold = w;
+        }
+        const uint64_t gap = load[hot] - load[cold];
+        if (gap < POOL_REBALANCE_MIN_GAP || gap * 4 < load[hot]) return;
+
+        // Best move: the book whose rate is closest to half the gap.  Rates of
+        // gap or more would just swap which worker is overloaded.
+        Assignment* best = nullptr;
+        uint64_t    bestError = 0;
+        for (Assignment& a : assignments_) {
+            if (a.worker != hot || a.migrating || a.rate == 0 || a.rate >= gap) continue;
+            const uint64_t error = a.rate * 2 > gap ? a.rate * 2 - gap : gap - a.rate * 2;
+            if (!best || error < bestError) { best = &a; bestError = error; }
+        }
+        if (!best) return;
+        best->worker    = cold;
+        best->migrating = true;
+        post(hot, Op{Op::RELEASE, best->book, cold, nullptr});
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool>                    running_;
+
+    std::mutex                           assignMutex_;   // guards assignments_
+    std::condition_variable              migrateCv_;
+    std::vector<Assignment>              assignments_;
+    unsigned                             ticksSinceRebalance_ = 0;  // TimerService thread
+};
+
+#endif // MATCHING_POOL_HPP
@@ -93,7 +93,7 @@ static const int CIRCULAR_RING_IDS[4] = {2500, 2600, 2700, 2800};
 //  CIRCULAR_STEP_MS, then signals the next thread.
 //
 //  TradingApplication::start() calls:
-//    CircularRingCoordinator::instance().init(orderBooks_[1], &logger_, 1);
+//    CircularRingCoordinator::instance().init(orderBooks_[1], 1);
 //    CircularRingCoordinator::instance().start();
 //  TradingApplication cleanup calls:
 //    CircularRingCoordinator::instance().stop();
@@ -105,11 +105,11 @@ public:
         return inst;
     }
 
-    // Must be called BEFORE start(). Supplies the shared orderbook and logger.
-    void init(std::shared_ptr<OrderBook> ob, Logger* log, int instrId) {
+    // Must be called BEFORE start(). Supplies the shared orderbook; the book
+    // logs every order event itself.
+    void init(std::shared_ptr<OrderBook> ob, int instrId) {
         std::lock_guard<std::mutex> lk(mtx_);
         orderBook_ = ob;
-        logger_    = log;
         instrId_   = instrId;
     }
 
@@ -120,7 +120,7 @@ public:
             if (!orderBook_) return; // init() was not called
             running_   = true;
             step_      = 0;
-            ringPrice_ = 0.0;
+            ringPrice_ = 0;
         }
         // Spawn one thread per ring member — they self-coordinate via step_ + cv_
         for (int i = 0; i < 4; ++i)
@@ -150,14 +150,16 @@ private:
 
     // ── Per-member thread body ────────────────────────────────────────────────
     void ringMemberLoop(int memberIdx) {
+        ThreadTuning::getInstance().pin(ThreadRole::TRADERS);
         std::mt19937 eng(std::random_device{}());
         std::uniform_real_distribution<double> jitter(
             1.0 - CIRCULAR_PRICE_JITTER, 1.0 + CIRCULAR_PRICE_JITTER);
-        const std::string traderId = std::to_string(CIRCULAR_RING_IDS[memberIdx]);
+        const TraderIndex trader = TraderRegistry::getInstance().intern(
+            std::to_string(CIRCULAR_RING_IDS[memberIdx]));
 
         while (true) {
             // ── Block until it's this member's turn in the 8-step cycle ──────
-            double    price = 0.0;
+            Price     price = 0;
             OrderSide side  = OrderSide::BUY;
             {
                 std::unique_lock<std::mutex> lk(mtx_);
@@ -171,10 +173,9 @@ private:
 
                 if (spec.setPrice) {
                     // BUY step — anchor a fresh ring price from the live market
-                    const Instrument* instr =
-                        InstrumentManager::getInstance().getInstrumentById(instrId_);
-                    double mkt = instr ? instr->marketPrice : 100.0;
-                    price      = std::round(mkt * jitter(eng) * 100.0) / 100.0;
+                    const Instrument& instr =
+                        *InstrumentManager::getInstance().getInstrumentById(instrId_);
+                    price      = instr.toTicks(instr.marketPrice * jitter(eng));
                     ringPrice_ = price; // stored so the next SELL step can reuse it
                 } else {
                     // SELL step — inherit the price from the immediately preceding
@@ -186,16 +187,14 @@ private:
 
             // ── Place the circular ring order (outside the lock) ──────────────
             if (orderBook_) {
-                auto order = std::make_shared<Order>(
+                orderBook_->submitOrder(OrderRequest{
                     OrderType::LIMIT,
                     side,
                     price,
                     CIRCULAR_QUANTITY,
                     TimeInForce::GTC,
-                    traderId,   // user_id = "2500" / "2600" / "2700" / "2800"
-                    instrId_);
-                orderBook_->addOrder(order);
-                if (logger_) logger_->logOrder(*order);
+                    trader,     // user_id = "2500" / "2600" / "2700" / "2800"
+                    instrId_});
             }
 
             // ── Pause BEFORE waking the next ring member ──────────────────────
@@ -225,11 +224,10 @@ private:
 
     // ── Members ───────────────────────────────────────────────────────────────
     std::shared_ptr<OrderBook>  orderBook_;
-    Logger*                     logger_    = nullptr;
     int                         instrId_   = 1;
     bool                        running_   = false;
     int                         step_      = 0;    // 0-7, shared step counter
-    double                      ringPrice_ = 0.0;  // price anchored by BUY steps
+    Price                       ringPrice_ = 0;    // ticks, anchored by BUY steps
     std::mutex                  mtx_;
     std::condition_variable     cv_;
     std::vector<std::thread>    threads_;
@@ -249,11 +247,135 @@ inline const CircularRingCoordinator::StepSpec CircularRingCoordinator::CYCLE[8]
 };
 
 
+// ═══════════════════════════════════════════════════════════════════════════════
+//  LIQUIDITY — MARKET MAKER  (trader ID 3000)
+//  ─────────────────────────────────────────────────────────────────────────────
+//  MARKET_MAKER_ACTIVE  master on/off switch.
+//    true  → trader #3000 keeps a two-sided quote of MARKET_MAKER_LEVELS levels
+//            per side in every book and refreshes all of them on every
+//            TimerService tick with OrderBook::submitMassQuote() — one book
+//            pass per instrument per tick, amending its resting quotes in
+//            place instead of cancelling and re-entering them.
+//    false → the desk never starts; books carry retail liquidity only.
+//
+//  Quotes sit around the instrument's marketPrice (jittered per refresh), the
+//  inner level MARKET_MAKER_HALF_SPREAD away from it and each further level
+//  another MARKET_MAKER_LEVEL_STEP out; every level is at least one tick
+//  from its neighbours.  QuestDB trade_logs carry user_id = "3000" and
+//  ORDER_AMENDED rows for each refresh that moved a quote.
+// ═══════════════════════════════════════════════════════════════════════════════
+static constexpr bool   MARKET_MAKER_ACTIVE      = false;  // ← true → quote every book each tick
+static constexpr int    MARKET_MAKER_USER_ID     = 3000;
+static constexpr size_t MARKET_MAKER_LEVELS      = 3;      // quote levels per side
+static constexpr size_t MARKET_MAKER_MIN_QTY     = 100;    // shares per level, drawn uniformly
+static constexpr size_t MARKET_MAKER_MAX_QTY     = 1000;
+static constexpr double MARKET_MAKER_HALF_SPREAD = 0.0005; // 5 bp from fair to the inner level
+static constexpr double MARKET_MAKER_LEVEL_STEP  = 0.0005; // 5 bp between levels
+static constexpr double MARKET_MAKER_JITTER      = 0.0002; // ±2 bp fair-price noise per refresh
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MarketMakerDesk
+//  ─────────────────────────────────────────────────────────────────────────────
+//  Singleton with one thread that walks every registered book once per
+//  TIMER_WHEEL_TICK_MS and submits a fresh mass quote for trader #3000.  In
+//  DEDICATED / POOLED mode the quotes are queued on each book's ring and the
+//  thread never waits for matching.
+//
+//  TradingApplication::start() calls (only when MARKET_MAKER_ACTIVE):
+//    MarketMakerDesk::instance().addBook(orderBooks_[id]);   // every book
+//    MarketMakerDesk::instance().start();
+//  TradingApplication cleanup calls:
+//    MarketMakerDesk::instance().stop();   // joins, then drops every book
+//  stop() must run before the books' owner (and its MatchingPool / Logger)
+//  is torn down: the desk must not be the last holder of a book.
+// ─────────────────────────────────────────────────────────────────────────────
+class MarketMakerDesk {
+public:
+    static MarketMakerDesk& instance() {
+        static MarketMakerDesk inst;
+        return inst;
+    }
+
+    // Must be called BEFORE start().
+    void addBook(std::shared_ptr<OrderBook> ob) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        books_.push_back(std::move(ob));
+    }
+
+    void start() {
+        if (!MARKET_MAKER_ACTIVE) return;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (books_.empty() || running_) return;
+            running_ = true;
+        }
+        thread_ = std::thread(&MarketMakerDesk::run, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) thread_.join();
+        std::lock_guard<std::mutex> lk(mtx_);
+        books_.clear();
+    }
+
+private:
+    void run() {
+        ThreadTuning::getInstance().pin(ThreadRole::TRADERS);
+        std::mt19937 eng(std::random_device{}());
+        std::uniform_real_distribution<double> jitter(
+            1.0 - MARKET_MAKER_JITTER, 1.0 + MARKET_MAKER_JITTER);
+        std::uniform_int_distribution<size_t> quantity(MARKET_MAKER_MIN_QTY, MARKET_MAKER_MAX_QTY);
+        const TraderIndex trader = TraderRegistry::getInstance().intern(
+            std::to_string(MARKET_MAKER_USER_ID));
+
+        std::unique_lock<std::mutex> lk(mtx_);
+        while (running_) {
+            for (const auto& ob : books_) {
+                const Instrument& instr = ob->getInstrument();
+                const double fair   = instr.marketPrice * jitter(eng);
+                const Price  center = instr.toTicks(fair);
+                const Price  inner  = std::max<Price>(1, instr.toTicks(fair * MARKET_MAKER_HALF_SPREAD));
+                const Price  step   = std::max<Price>(1, instr.toTicks(fair * MARKET_MAKER_LEVEL_STEP));
+
+                MassQuote quote{trader, {}, {}};
+                for (size_t k = 0; k < MARKET_MAKER_LEVELS; ++k) {
+                    const Price offset = inner + static_cast<Price>(k) * step;
+                    if (center - offset > 0)
+                        quote.bids.push_back(QuoteLevel{center - offset, quantity(eng)});
+                    quote.asks.push_back(QuoteLevel{center + offset, quantity(eng)});
+                }
+                ob->submitMassQuote(std::move(quote));
+            }
+            cv_.wait_for(lk, std::chrono::milliseconds(TIMER_WHEEL_TICK_MS),
+                         [this] { return !running_; });
+        }
+    }
+
+    // ── Private constructor / copy-delete (singleton) ─────────────────────────
+    MarketMakerDesk()  = default;
+    ~MarketMakerDesk() { stop(); }
+    MarketMakerDesk(const MarketMakerDesk&) = delete;
+    MarketMakerDesk& operator=(const MarketMakerDesk&) = delete;
+
+    // ── Members ───────────────────────────────────────────────────────────────
+    std::vector<std::shared_ptr<OrderBook>> books_;
+    bool                                    running_ = false;
+    std::mutex                              mtx_;
+    std::condition_variable                 cv_;
+    std::thread                             thread_;
+};
+
+
 class MockTrader {
 public:
     static int mockTraderCount;
 
-    MockTrader(std::shared_ptr<OrderBook> orderBook, int instrumentId, Logger* logger = nullptr)
+    MockTrader(std::shared_ptr<OrderBook> orderBook, int instrumentId)
         : orderBook_(orderBook)
         , instrumentId_(instrumentId)
         , running_(false)
@@ -263,13 +385,12 @@ public:
         , sleepDistribution_(100, 2000)      // 100–2000 ms think time (retail)
         , sideDistribution_(0, 1)           // random BUY / SELL      (retail)
         , washPriceJitter_(0.999, 1.001)    // ±0.1 % price noise     (wash)
-        , logger_(logger)
     {
         if (mockTraderCount >= 10000)
             throw std::runtime_error("Max 10 000 mock traders allowed");
 
-        int myId  = mockTraderCount++;
-        traderId_ = std::to_string(myId);
+        int myId = mockTraderCount++;
+        trader_  = TraderRegistry::getInstance().intern(std::to_string(myId));
 
         // ── Designate trader #2500 as the wash-trade manipulator ─────────────
         // Flip WASH_TRADER_ACTIVE to false to revert #2500 to retail behaviour.
@@ -294,8 +415,6 @@ public:
     }
 
 private:
-    Logger* logger_;
-
     // ──────────────────────────────────────────────────────────────────────────
     //  RETAIL TRADER  (9996 normal mock traders plus 2600 / 2700 / 2800)
     //  Behaviour: random side, random order type, random price & quantity.
@@ -311,18 +430,16 @@ private:
             OrderType orderType = (quantityDistribution_(engine_) % 2 == 0)
                                       ? OrderType::LIMIT : OrderType::MARKET;
 
-            const Instrument* instr =
-                InstrumentManager::getInstance().getInstrumentById(instrumentId_);
-            double basePrice = instr ? instr->marketPrice : 100.0;
-            double price     = basePrice * priceDistribution_(engine_);
-            auto   quantity  = quantityDistribution_(engine_);
+            const Instrument& instr =
+                *InstrumentManager::getInstance().getInstrumentById(instrumentId_);
+            // Snap to the instrument's tick grid so orders share price levels
+            // instead of each opening a fresh one at an arbitrary double.
+            Price  price     = instr.toTicks(instr.marketPrice * priceDistribution_(engine_));
+            size_t quantity  = quantityDistribution_(engine_) * instr.lotSize;
 
-            auto order = std::make_shared<Order>(
+            orderBook_->submitOrder(OrderRequest{
                 orderType, side, price, quantity,
-                TimeInForce::GTC, traderId_, instrumentId_);
-
-            orderBook_->addOrder(order);
-            if (logger_) logger_->logOrder(*order);
+                TimeInForce::GTC, trader_, instrumentId_});
         }
     }
 
@@ -352,35 +469,29 @@ private:
 
             for (int pair = 0; pair < WASH_BURST_PAIRS && running_; ++pair) {
 
-                const Instrument* instr =
-                    InstrumentManager::getInstance().getInstrumentById(instrumentId_);
-                double marketPrice = instr ? instr->marketPrice : 100.0;
+                const Instrument& instr =
+                    *InstrumentManager::getInstance().getInstrumentById(instrumentId_);
 
                 // Tiny jitter keeps the price from looking artificially static,
                 // but BOTH legs of each pair share the EXACT same washPrice.
-                double washPrice = marketPrice * washPriceJitter_(engine_);
-                washPrice = std::round(washPrice * 100.0) / 100.0; // 2 d.p.
+                Price washPrice = instr.toTicks(instr.marketPrice * washPriceJitter_(engine_));
 
                 // ── Leg 1 : BUY ──────────────────────────────────────────────
-                auto buyOrder = std::make_shared<Order>(
+                orderBook_->submitOrder(OrderRequest{
                     OrderType::LIMIT, OrderSide::BUY,
                     washPrice, WASH_QUANTITY,
-                    TimeInForce::GTC, traderId_, instrumentId_);
-                orderBook_->addOrder(buyOrder);
-                if (logger_) logger_->logOrder(*buyOrder);
+                    TimeInForce::GTC, trader_, instrumentId_});
 
                 std::this_thread::sleep_for(
                     std::chrono::milliseconds(WASH_INTERVAL_MS));
                 if (!running_) break;
 
                 // ── Leg 2 : SELL — mirrors Leg 1 exactly ─────────────────────
-                auto sellOrder = std::make_shared<Order>(
+                orderBook_->submitOrder(OrderRequest{
                     OrderType::LIMIT, OrderSide::SELL,
                     washPrice,      // ← same price as BUY  (red flag ✦)
                     WASH_QUANTITY,  // ← same qty  as BUY   (red flag ✦)
-                    TimeInForce::GTC, traderId_, instrumentId_);
-                orderBook_->addOrder(sellOrder);
-                if (logger_) logger_->logOrder(*sellOrder);
+                    TimeInForce::GTC, trader_, instrumentId_});
 
                 std::this_thread::sleep_for(
                     std::chrono::milliseconds(WASH_INTERVAL_MS));
@@ -393,6 +504,7 @@ private:
 
     // Dispatch to the correct primary behaviour for this trader.
     void run() {
+        ThreadTuning::getInstance().pin(ThreadRole::TRADERS);
         if (isWashTrader_)
             runWash();
         else
@@ -401,7 +513,7 @@ private:
 
     // ── Members ───────────────────────────────────────────────────────────────
     std::shared_ptr<OrderBook> orderBook_;
-    std::string                traderId_;
+    TraderIndex                trader_ = INVALID_TRADER;
     bool                       isWashTrader_ = false;
     std::atomic<bool>          running_;
     std::thread                thread_;
@@ -0,0 +1,81 @@
+#ifndef MPSC_RING_HPP
+#define MPSC_RING_HPP
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MpscRing — bounded lock-free multi-producer / single-consumer queue.
+//
+//  A power-of-two array of cells, each with its own sequence number (the
+//  Vyukov bounded-queue scheme).  Producers claim a cell with one CAS on the
+//  tail and publish it by bumping the cell's sequence; the single consumer
+//  reads cells in order from the head with no atomic RMW at all.  Nothing
+//  allocates after construction and no thread ever waits on a lock: a full
+//  ring makes tryPush() fail and the producer decides how to back off.
+// ─────────────────────────────────────────────────────────────────────────────
+template <typename T, size_t Capacity>
+class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscRing capacity must be a power of two");
+
+public:
+    MpscRing() : cells_(new Cell[Capacity]) {
+        for (size_t i = 0; i < Capacity; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&)            = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any thread.  Returns false (and leaves `value` intact) if full.
+    bool tryPush(T&& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (Capacity - 1)];
+            const size_t seq  = cell.sequence.load(std::memory_order_acquire);
+            const auto   diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;                                   // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);    // lost the race
+            }
+        }
+    }
+
+    // Consumer thread only.  Returns false if empty.
+    bool tryPop(T& out) {
+        Cell& cell = cells_[head_ & (Capacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = std::move(cell.value);
+        cell.sequence.store(head_ + Capacity, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Consumer thread only.
+    bool empty() const {
+        return cells_[head_ & (Capacity - 1)].sequence.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T                   value;
+    };
+
+    std::unique_ptr<Cell[]>          cells_;
+    alignas(64) std::atomic<size_t>  tail_{0};   // producers
+    alignas(64) size_t               head_ = 0;  // consumer
+};
+
+#endif // MPSC_RING_HPP
@@ -0,0 +1,111 @@
+#ifndef OCCUPANCY_BITMAP_HPP
+#define OCCUPANCY_BITMAP_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OccupancyBitmap — hierarchical set of slot indices in [0, size).
+//
+//  Level 0 holds one bit per slot in 64-bit words; every level above holds
+//  one bit per non-zero word of the level below, up to a single summary word.
+//  A 2^18-slot ladder needs three levels, so finding the next occupied slot
+//  in either direction is at most three ctz/clz steps up and three down,
+//  however far away that slot is.
+//
+//  Not thread-safe: owned and guarded by the OrderBook like the ladder itself.
+// ─────────────────────────────────────────────────────────────────────────────
+class OccupancyBitmap {
+public:
+    explicit OccupancyBitmap(size_t size) {
+        size_t words = (size + 63) / 64;
+        for (;;) {
+            if (words == 0) words = 1;
+            levels_.emplace_back(words, 0);
+            if (words == 1) break;
+            words = (words + 63) / 64;
+        }
+    }
+
+    bool test(size_t i) const {
+        return (levels_[0][i >> 6] >> (i & 63)) & 1;
+    }
+
+    void set(size_t i) {
+        for (auto& level : levels_) {
+            uint64_t& word    = level[i >> 6];
+            const bool wasSet = word != 0;
+            word |= bit(i & 63);
+            if (wasSet) return;      // upper levels already mark this word
+            i >>= 6;
+        }
+    }
+
+    void clear(size_t i) {
+        for (auto& level : levels_) {
+            uint64_t& word = level[i >> 6];
+            word &= ~bit(i & 63);
+            if (word != 0) return;   // word still occupied: parents unchanged
+            i >>= 6;
+        }
+    }
+
+    void reset() {
+        for (auto& level : levels_) level.assign(level.size(), 0);
+    }
+
+    bool empty() const { return levels_.back()[0] == 0; }
+
+    // Lowest / highest set index, or -1 when empty.
+    long lowest() const {
+        if (empty()) return -1;
+        return descendLow(levels_.size() - 1, static_cast<size_t>(__builtin_ctzll(levels_.back()[0])));
+    }
+    long highest() const {
+        if (empty()) return -1;
+        return descendHigh(levels_.size() - 1, static_cast<size_t>(63 - __builtin_clzll(levels_.back()[0])));
+    }
+
+    // Lowest set index strictly above `i`, or -1.
+    long nextAbove(size_t i) const {
+        for (size_t k = 0; k < levels_.size(); ++k) {
+            const size_t   b    = i & 63;
+            const uint64_t word = b == 63 ? 0 : levels_[k][i >> 6] & (~uint64_t(0) << (b + 1));
+            if (word)
+                return descendLow(k, ((i >> 6) << 6) | static_cast<size_t>(__builtin_ctzll(word)));
+            i >>= 6;
+        }
+        return -1;
+    }
+
+    // Highest set index strictly below `i`, or -1.
+    long nextBelow(size_t i) const {
+        for (size_t k = 0; k < levels_.size(); ++k) {
+            const uint64_t word = levels_[k][i >> 6] & (bit(i & 63) - 1);
+            if (word)
+                return descendHigh(k, ((i >> 6) << 6) | static_cast<size_t>(63 - __builtin_clzll(word)));
+            i >>= 6;
+        }
+        return -1;
+    }
+
+private:
+    static uint64_t bit(size_t b) { return uint64_t(1) << b; }
+
+    // `idx` is a set bit at `level`; follow the lowest/highest child down.
+    long descendLow(size_t level, size_t idx) const {
+        while (level-- > 0)
+            idx = (idx << 6) | static_cast<size_t>(__builtin_ctzll(levels_[level][idx]));
+        return static_cast<long>(idx);
+    }
+    long descendHigh(size_t level, size_t idx) const {
+        while (level-- > 0)
+            idx = (idx << 6) | static_cast<size_t>(63 - __builtin_clzll(levels_[level][idx]));
+        return static_cast<long>(idx);
+    }
+
+    std::vector<std::vector<uint64_t>> levels_;  // [0] = slots, back() = summary
+};
+
+#endif // OCCUPANCY_BITMAP_HPP
@@ -3,30 +3,110 @@
 
 #include <string>
 #include <chrono>
-#include <random>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include "Instrument.hpp"
+#include "TraderRegistry.hpp"
 
-enum class OrderType {
+class PriceLevel;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OrderId — 64-bit order identifier.
+//
+//    bits 63..48  instrument ID
+//    bits 47..0   per-book sequence
+//
+//  Each OrderBook hands out sequences from a single atomic counter, so IDs are
+//  unique without a lock or an RNG.  The counter is seeded with
+//  (seconds since 2024-01-01) << 20 at startup: a restart begins above every
+//  ID the previous run could have issued unless that run averaged more than
+//  ~1M orders per second per book, so rows already in QuestDB never collide.
+//  The string form "<instrumentId>-<sequence>" is produced only at the output
+//  boundary (ILP rows, HTTP, terminal) and keeps split_part(order_id,'-',1)
+//  equal to the instrument ID.
+// ─────────────────────────────────────────────────────────────────────────────
+using OrderId = uint64_t;
+
+static constexpr unsigned ORDER_ID_SEQUENCE_BITS = 48;
+static constexpr uint64_t ORDER_ID_SEQUENCE_MASK = (uint64_t(1) << ORDER_ID_SEQUENCE_BITS) - 1;
+static constexpr int64_t  ORDER_ID_EPOCH_SECONDS = 1704067200; // 2024-01-01T00:00:00Z
+
+inline OrderId makeOrderId(int instrumentId, uint64_t sequence) {
+    return (static_cast<uint64_t>(instrumentId) << ORDER_ID_SEQUENCE_BITS) |
+           (sequence & ORDER_ID_SEQUENCE_MASK);
+}
+
+inline int      orderIdInstrument(OrderId id) { return static_cast<int>(id >> ORDER_ID_SEQUENCE_BITS); }
+inline uint64_t orderIdSequence(OrderId id)   { return id & ORDER_ID_SEQUENCE_MASK; }
+
+// First sequence a book hands out in this process (see above).
+inline uint64_t initialOrderSequence() {
+    int64_t secs = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count() - ORDER_ID_EPOCH_SECONDS;
+    return (static_cast<uint64_t>(secs > 0 ? secs : 0) << 20) & ORDER_ID_SEQUENCE_MASK;
+}
+
+inline std::string formatOrderId(OrderId id) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%d-%llu", orderIdInstrument(id),
+                  static_cast<unsigned long long>(orderIdSequence(id)));
+    return std::string(buf);
+}
+
+// Trade IDs use the same per-book sequence scheme; rendered "TRD-<instr>-<seq>".
+inline std::string formatTradeId(int instrumentId, uint64_t sequence) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "TRD-%d-%llu", instrumentId,
+                  static_cast<unsigned long long>(sequence));
+    return std::string(buf);
+}
+
+// Parse "<instrumentId>-<sequence>" (user input).  Returns false if malformed.
+inline bool parseOrderId(const std::string& text, OrderId& out) {
+    const char* s = text.c_str();
+    char* end = nullptr;
+    long instrument = std::strtol(s, &end, 10);
+    if (end == s || *end != '-' || instrument < 0 || instrument > 0xFFFF) return false;
+    const char* seqStart = end + 1;
+    unsigned long long sequence = std::strtoull(seqStart, &end, 10);
+    if (end == seqStart || *end != '\0' || sequence > ORDER_ID_SEQUENCE_MASK) return false;
+    out = makeOrderId(static_cast<int>(instrument), sequence);
+    return true;
+}
+
+enum class OrderType : uint8_t {
     LIMIT,
-    MARKET
+    MARKET,
+    STOP,        // parked until the last trade reaches stopPrice, then MARKET
+    STOP_LIMIT   // parked until the last trade reaches stopPrice, then LIMIT at price
 };
 
-enum class OrderSide {
+inline const char* orderTypeName(OrderType type) {
+    switch (type) {
+        case OrderType::LIMIT:      return "LIMIT";
+        case OrderType::MARKET:     return "MARKET";
+        case OrderType::STOP:       return "STOP";
+        case OrderType::STOP_LIMIT: return "STOP_LIMIT";
+    }
+    return "UNKNOWN";
+}
+
+enum class OrderSide : uint8_t {
     BUY,
     SELL
 };
 
-enum class TimeInForce {
+enum class TimeInForce : uint8_t {
     GTC,    // Good Till Cancelled
     IOC,    // Immediate or Cancel
     FOK,    // Fill or Kill
-    DAY     // Day Order
+    DAY,    // Day Order
+    GTT     // Good Till Time (OrderRequest::expireAt)
 };
 
-enum class OrderStatus {
+enum class OrderStatus : uint8_t {
     NEW,
     PARTIALLY_FILLED,
     FILLED,
@@ -34,39 +114,151 @@ enum class OrderStatus {
     EXPIRED
 };
 
-class Order {
+// Dense slot index of an Order inside its book's OrderPool.
+using OrderHandle = uint32_t;
+static constexpr OrderHandle INVALID_ORDER_HANDLE = UINT32_MAX;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OrderRequest — what a caller submits to OrderBook::addOrder().
+//
+//  A plain value: the book constructs the Order itself inside its pool, so
+//  callers never own (or allocate) Order objects.
+// ─────────────────────────────────────────────────────────────────────────────
+struct OrderRequest {
+    OrderType   type;
+    OrderSide   side;
+    Price       price;          // in ticks of the instrument
+    size_t      quantity;
+    TimeInForce timeInForce;
+    TraderIndex trader;         // from TraderRegistry::intern()
+    int         instrumentId;
+    bool        isShortSell = false;
+    std::chrono::system_clock::time_point expireAt{}; // GTT only; must be in the future
+    Price       stopPrice = 0;  // STOP / STOP_LIMIT trigger, in ticks
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Order — the hot matching record: exactly one 64-byte cache line.
+//
+//  Only what the matching loop reads or writes lives here (price, remaining
+//  quantity, side/TIF/status, queue links, trader for the trade record), so a
+//  deep sweep touches one line per resting order.  Everything else — original
+//  quantity, timestamps, enrichment strings and the last-trade context — is
+//  in the OrderDetails record stored in the same OrderPool slot and is read
+//  by the logger and queries.  The instrument is not stored: it is encoded in
+//  the top bits of the OrderId.
+// ─────────────────────────────────────────────────────────────────────────────
+class alignas(64) Order {
 public:
-    Order(OrderType type, OrderSide side, double price, size_t quantity,
-          TimeInForce tif, const std::string& traderId, int instrumentId,
-          bool isShortSell = false)
-        : orderId_(generateOrderId(instrumentId, traderId))
-        , type_(type)
-        , side_(side)
-        , price_(price)
-        , quantity_(quantity)
-        , remainingQuantity_(quantity)
-        , timeInForce_(tif)
-        , traderId_(traderId)
-        , instrumentId_(instrumentId)
+    // price is in ticks of the instrument (see Instrument::toTicks).
+    Order(OrderId orderId, const OrderRequest& request)
+        : orderId_(orderId)
+        , price_(request.price)
+        , remainingQuantity_(request.quantity)
+        , trader_(request.trader)
+        , type_(request.type)
+        , side_(request.side)
+        , timeInForce_(request.timeInForce)
         , status_(OrderStatus::NEW)
-        , submitTimestamp_(std::chrono::system_clock::now())
-        , cancelTimestamp_()           // zero-initialised (epoch)
-        , isShortSell_(isShortSell)
-        , marketPhase_(computeMarketPhase(submitTimestamp_))
-        , deviceIdHash_(computeDeviceIdHash(traderId))
+        , isShortSell_(request.isShortSell)
     {}
 
     // ── Existing getters ──────────────────────────────────────────────────────
-    const std::string& getOrderId()       const { return orderId_; }
+    OrderId            getOrderId()       const { return orderId_; }
     OrderType          getType()          const { return type_; }
     OrderSide          getSide()          const { return side_; }
-    double             getPrice()         const { return price_; }
-    size_t             getQuantity()      const { return quantity_; }
+    Price              getPriceTicks()    const { return price_; }
     size_t             getRemainingQuantity() const { return remainingQuantity_; }
     TimeInForce        getTimeInForce()   const { return timeInForce_; }
-    const std::string& getTraderId()      const { return traderId_; }
+    TraderIndex        getTrader()        const { return trader_; }
+    const std::string& getTraderId()      const { return TraderRegistry::getInstance().name(trader_); }
     OrderStatus        getStatus()        const { return status_; }
-    int                getInstrumentId()  const { return instrumentId_; }
+    int                getInstrumentId()  const { return orderIdInstrument(orderId_); }
+    bool               isShortSell()      const { return isShortSell_; }
+
+    // Rupee price — for display, ILP and JSON only; matching uses getPriceTicks().
+    double getPrice() const {
+        return InstrumentManager::getInstance().toPrice(getInstrumentId(), price_);
+    }
+
+    // ── Setter (allows callers to flag a sell as a short-sell explicitly) ─────
+    void setIsShortSell(bool v) { isShortSell_ = v; }
+
+    // ── Lifecycle ─────────────────────────────────────────────────────────────
+    void fill(size_t quantity) {
+        remainingQuantity_ -= quantity;
+        status_ = (remainingQuantity_ == 0) ? OrderStatus::FILLED
+                                            : OrderStatus::PARTIALLY_FILLED;
+    }
+
+    // Returns false if the order was already terminal.
+    bool cancel() {
+        if (status_ == OrderStatus::CANCELLED ||
+            status_ == OrderStatus::FILLED    ||
+            status_ == OrderStatus::EXPIRED) return false;
+        status_ = OrderStatus::CANCELLED;
+        return true;
+    }
+
+    void expire() {
+        status_ = OrderStatus::EXPIRED;
+    }
+
+    // New price / open quantity for a resting order (OrderBook::amendOrder()).
+    // The status is unchanged: an amended order is still NEW or PARTIAL.
+    void amend(Price price, size_t remainingQuantity) {
+        price_             = price;
+        remainingQuantity_ = remainingQuantity;
+    }
+
+    // Level this order currently rests on (nullptr when not in the book).
+    PriceLevel* getLevel() const { return level_; }
+
+    // Slot in the owning book's OrderPool (INVALID_ORDER_HANDLE if not pooled).
+    OrderHandle getPoolHandle() const { return poolHandle_; }
+
+private:
+    friend class PriceLevel; // maintains the intrusive queue links below
+    friend class OrderPool;  // stamps poolHandle_
+
+    // ── Members (ordered by size; see static_assert below) ───────────────────
+    OrderId     orderId_;
+    Price       price_;                 // in ticks
+    size_t      remainingQuantity_;
+
+    // ── Intrusive FIFO links (owned by PriceLevel, guarded by the book mutex) ─
+    PriceLevel* level_       = nullptr;
+    Order*      prevInLevel_ = nullptr;
+    Order*      nextInLevel_ = nullptr;
+
+    TraderIndex trader_;
+    OrderHandle poolHandle_  = INVALID_ORDER_HANDLE;
+    OrderType   type_;
+    OrderSide   side_;
+    TimeInForce timeInForce_;
+    OrderStatus status_;
+    bool        isShortSell_;           // true if this is a naked/covered short sale
+};
+
+static_assert(sizeof(Order) == 64, "Order must stay one cache line");
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OrderDetails — cold per-order data, stored beside the Order in its pool
+//  slot (OrderPool::details()).  Written at placement, on each fill (trade
+//  context) and on cancel; read when an order event is logged or queried.
+// ─────────────────────────────────────────────────────────────────────────────
+class OrderDetails {
+public:
+    explicit OrderDetails(const OrderRequest& request)
+        : quantity_(request.quantity)
+        , submitTimestamp_(std::chrono::system_clock::now())
+        , cancelTimestamp_()           // zero-initialised (epoch)
+        , expireAt_(request.expireAt)
+        , stopPrice_(request.stopPrice)
+        , marketPhase_(computeMarketPhase(submitTimestamp_))
+    {}
+
+    size_t getQuantity() const { return quantity_; }
 
     // Legacy alias — keep existing callers happy
     const std::chrono::system_clock::time_point& getTimestamp() const {
@@ -80,79 +272,44 @@ public:
     const std::chrono::system_clock::time_point& getCancelTimestamp() const {
         return cancelTimestamp_;
     }
-    bool               isShortSell()      const { return isShortSell_; }
     const std::string& getMarketPhase()   const { return marketPhase_; }
-    const std::string& getDeviceIdHash()  const { return deviceIdHash_; }
-
-    // ── Setter (allows callers to flag a sell as a short-sell explicitly) ─────
-    void setIsShortSell(bool v) { isShortSell_ = v; }
 
-    // ── Public utility: deterministic FNV-1a device fingerprint ──────────────
-    // Exposed as public static so Logger can compute a hash for the aggressor
-    // user on TRADE_MATCH rows without needing an Order object.
-    static std::string computeDeviceIdHash(const std::string& traderId) {
-        uint32_t hash = 2166136261u; // FNV-1a offset basis
-        for (unsigned char c : traderId) {
-            hash ^= c;
-            hash *= 16777619u; // FNV prime
-        }
-        char buf[9];
-        std::snprintf(buf, sizeof(buf), "%08X", hash);
-        return std::string(buf);
+    // Requested expiry time (GTT orders only; epoch otherwise).
+    const std::chrono::system_clock::time_point& getExpireAt() const {
+        return expireAt_;
     }
 
-    // ── Trade-context getters (populated by fillWithTradeContext) ─────────────
-    // These let Logger::logOrder() write the real trade_id, buyer_user_id and
-    // seller_user_id into every order-event row — even for non-TRADE_MATCH rows.
-    // Before a match occurs the values are "NA" (same as before this change).
-    const std::string& getMatchedTradeId()       const { return matchedTradeId_;        }
-    const std::string& getCounterpartyBuyerUid() const { return counterpartyBuyerUid_;  }
-    const std::string& getCounterpartySellerUid()const { return counterpartySellerUid_; }
+    // Trigger price in ticks (STOP / STOP_LIMIT orders only; 0 otherwise).
+    Price getStopPrice() const { return stopPrice_; }
 
-    // ── Lifecycle ─────────────────────────────────────────────────────────────
-    void fill(size_t quantity) {
-        remainingQuantity_ -= quantity;
-        status_ = (remainingQuantity_ == 0) ? OrderStatus::FILLED
-                                            : OrderStatus::PARTIALLY_FILLED;
-    }
+    void stampCancel() { cancelTimestamp_ = std::chrono::system_clock::now(); }
 
-    // Called by OrderBook::executeTrade() — embeds full trade context into the
-    // Order so that any subsequent logOrder() call carries the real IDs instead
-    // of "NA".  Both the incoming order and the resting order receive the same
-    // trade_id, buyer_user_id, seller_user_id for the matched execution.
-    void fillWithTradeContext(size_t quantity,
-                              const std::string& tradeId,
-                              const std::string& buyerUid,
-                              const std::string& sellerUid) {
-        matchedTradeId_       = tradeId;
-        counterpartyBuyerUid_ = buyerUid;
-        counterpartySellerUid_= sellerUid;
-        fill(quantity);
-    }
+    // Amended total order quantity (filled + still open).
+    void setQuantity(size_t quantity) { quantity_ = quantity; }
 
-    void cancel() {
-        if (status_ != OrderStatus::CANCELLED &&
-            status_ != OrderStatus::FILLED    &&
-            status_ != OrderStatus::EXPIRED) {
-            status_          = OrderStatus::CANCELLED;
-            cancelTimestamp_ = std::chrono::system_clock::now(); // stamp cancel time
-        }
+    // ── Trade-context getters (populated by setTradeContext) ──────────────────
+    // These let Logger::logOrder() write the real trade_id, buyer_user_id and
+    // seller_user_id into every order-event row — even for non-TRADE_MATCH rows.
+    // Before a match occurs the values are "NA" (same as before this change).
+    // Only integers are stored; strings are rendered at output time (the
+    // trader columns via TraderRegistry::tagOrNA()).
+    bool hasTradeContext() const { return counterpartyBuyer_ != INVALID_TRADER; }
+    std::string getMatchedTradeId(int instrumentId) const {
+        return hasTradeContext() ? formatTradeId(instrumentId, matchedTradeSeq_) : "NA";
     }
+    TraderIndex getCounterpartyBuyer()  const { return counterpartyBuyer_;  }
+    TraderIndex getCounterpartySeller() const { return counterpartySeller_; }
 
-    void expire() {
-        status_ = OrderStatus::EXPIRED;
+    // Called by OrderBook::executeTrade() for both matched orders, so any
+    // subsequent logOrder() call carries the real IDs instead of "NA".
+    void setTradeContext(uint64_t tradeSequence, TraderIndex buyer, TraderIndex seller) {
+        matchedTradeSeq_    = tradeSequence;
+        counterpartyBuyer_  = buyer;
+        counterpartySeller_ = seller;
     }
 
 private:
-    // ── Helpers ───────────────────────────────────────────────────────────────
-
-    // Generates orderId as instrumentId-random10DigitNumber-traderId
-    static std::string generateOrderId(int instrumentId, const std::string& traderId) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<long long> dis(1000000000LL, 9999999999LL);
-        return std::to_string(instrumentId) + "-" + std::to_string(dis(gen)) + "-" + traderId;
-    }
+    friend class TraderOrderIndex; // maintains the per-trader links below
 
     // ── Market-phase classification ───────────────────────────────────────────
     // Indian market schedule (IST = UTC + 5h 30m):
@@ -176,34 +333,28 @@ private:
         return "CLOSED";
     }
 
-    // ── Members ───────────────────────────────────────────────────────────────
-    std::string                          orderId_;
-    OrderType                            type_;
-    OrderSide                            side_;
-    double                               price_;
-    size_t                               quantity_;
-    int                                  instrumentId_;
-    size_t                               remainingQuantity_;
-    TimeInForce                          timeInForce_;
-    std::string                          traderId_;
-    OrderStatus                          status_;
-
-    // ── New timestamp fields ──────────────────────────────────────────────────
+    size_t quantity_;                // order quantity (as last amended)
+
+    // ── Timestamp fields ──────────────────────────────────────────────────────
     std::chrono::system_clock::time_point submitTimestamp_;  // when order was placed
     std::chrono::system_clock::time_point cancelTimestamp_;  // epoch-zero until cancelled
+    std::chrono::system_clock::time_point expireAt_;         // GTT expiry, epoch otherwise
+    Price                                 stopPrice_;        // ticks; STOP / STOP_LIMIT only
 
-    // ── New enrichment fields ─────────────────────────────────────────────────
-    bool        isShortSell_;   // true if this is a naked/covered short sale
+    // ── Enrichment fields ─────────────────────────────────────────────────────
     std::string marketPhase_;   // PRE_OPEN | OPEN | CLOSED  (computed at placement)
-    std::string deviceIdHash_;  // 8-char hex FNV-1a fingerprint of traderId
 
-    // ── Trade-context fields (set by fillWithTradeContext, default "NA") ──────
+    // ── Trade-context fields (set by setTradeContext, default "NA") ───────────
     // Populated the moment this order participates in a match so that
     // Logger::logOrder() can write real IDs instead of "NA" for every status
     // event (PARTIAL, FILLED, and also CANCELLED/EXPIRED after partial fills).
-    std::string matchedTradeId_        = "NA";
-    std::string counterpartyBuyerUid_  = "NA";
-    std::string counterpartySellerUid_ = "NA";
+    uint64_t    matchedTradeSeq_    = 0;
+    TraderIndex counterpartyBuyer_  = INVALID_TRADER;
+    TraderIndex counterpartySeller_ = INVALID_TRADER;
+
+    // ── Per-trader links (owned by TraderOrderIndex, guarded by the book mutex) ─
+    OrderHandle prevOfTrader_ = INVALID_ORDER_HANDLE;
+    OrderHandle nextOfTrader_ = INVALID_ORDER_HANDLE;
 };
 
-#endif // ORDER_HPP
\ No newline at end of file
+#endif // ORDER_HPP
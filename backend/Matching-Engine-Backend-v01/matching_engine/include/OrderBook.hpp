@@ -5,82 +5,499 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
-#include <thread>
-#include <unordered_map>
 #include <vector>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <optional>
+#include <sstream>
+#include <thread>
 #include "PriceLevel.hpp"
+#include "BookSide.hpp"
+#include "PriceLadder.hpp"
+#include "OrderPool.hpp"
+#include "OrderIndex.hpp"
+#include "TraderOrderIndex.hpp"
+#include "StopBook.hpp"
+#include "TimerWheel.hpp"
+#include "TimerService.hpp"
+#include "MpscRing.hpp"
+#include "ThreadTuning.hpp"
+#include "BookSnapshot.hpp"
+#include "DepthCache.hpp"
+#include "MarketDataFeed.hpp"
 #include "Trade.hpp"
 #include "Logger.hpp"
 
-// Orders expire if still pending (NEW or PARTIAL) after this many seconds.
-static constexpr int ORDER_EXPIRY_SECONDS = 5;
+// Level container used when the caller does not pick one (see BookType).
+static constexpr BookType DEFAULT_BOOK_TYPE = BookType::MAP;
+
+// LADDER books give array slots to prices within ±LADDER_SPAN_FRACTION of
+// the instrument's market price (capped at LADDER_MAX_WINDOW ticks per side);
+// anything further away lands in the ladder's overflow map.
+static constexpr double LADDER_SPAN_FRACTION = 0.08;
+static constexpr size_t LADDER_MAX_WINDOW    = size_t(1) << 18;
+
+// How an OrderBook's matching code is driven.
+enum class ExecutionMode {
+    LOCKED,     // callers match on their own thread under the book mutex
+    DEDICATED,  // one matching thread per book, fed through an MpscRing
+    POOLED      // MpscRing-fed, polled by a MatchingPool worker (MatchingPool.hpp)
+};
+
+static constexpr ExecutionMode DEFAULT_EXECUTION_MODE = ExecutionMode::LOCKED;
+
+// DEDICATED / POOLED books: command ring slots (power of two), and how many
+// queued commands the consumer runs per acquisition of the book mutex.
+static constexpr size_t BOOK_COMMAND_RING_SIZE = 4096;
+static constexpr size_t BOOK_COMMAND_BATCH     = 64;
+
+// DAY orders expire at the session close that follows their placement:
+// 15:30 IST, i.e. 10:00 UTC (same schedule as OrderDetails' market phase).
+static constexpr int SESSION_CLOSE_UTC_SECONDS = 10 * 3600;
+
+// Result of OrderBook::addOrder().  The Order itself lives in the book's pool
+// and may already have been recycled (fully filled, or a MARKET / IOC / FOK
+// remainder that was cancelled) by the time the caller sees this, so
+// everything the caller needs is copied here.  A STOP / STOP_LIMIT order
+// that did not trigger on entry is parked: status NEW, not resting, and
+// still cancellable until it triggers.
+struct OrderAck {
+    OrderId     orderId;
+    OrderStatus status;
+    size_t      filledQuantity;
+    size_t      remainingQuantity;
+    bool        resting;          // true if the remainder now rests in the book
+};
+
+// Completion callbacks for submitOrder() / submitCancel() / submitAmend().
+// In DEDICATED and POOLED mode they run on the book's matching thread: keep
+// them short, and never wait on any book from inside one (e.g. by calling
+// addOrder()).
+using OrderAckCallback     = std::function<void(const OrderAck&)>;
+using CancelResultCallback = std::function<void(bool)>;
+using AmendResultCallback  = std::function<void(const std::optional<OrderAck>&)>;
+using OrderBatchCallback   = std::function<void(const std::vector<OrderAck>&)>;
+using CancelBatchCallback  = std::function<void(const std::vector<bool>&)>;
+
+// One slot of a mass quote: price in ticks and open quantity; quantity 0
+// withdraws whatever the trader had quoted in that slot.
+struct QuoteLevel {
+    Price  price;
+    size_t quantity;
+};
+
+// A trader's complete two-sided quote for one book, best slot first per side.
+struct MassQuote {
+    TraderIndex             trader;
+    std::vector<QuoteLevel> bids;
+    std::vector<QuoteLevel> asks;
+};
+
+// One OrderAck per slot, bids then asks (orderId 0 for a withdrawn slot);
+// empty if the quote was rejected.
+using MassQuoteCallback = std::function<void(const std::vector<OrderAck>&)>;
+
+// Number of orders a mass cancel took out of the book.
+using MassCancelCallback = std::function<void(size_t)>;
+
+class OrderBook;
+
+// Owner of POOLED books (implemented by MatchingPool): receives wake-ups when
+// a book has new work, and takes the book back before it is destroyed.
+class BookScheduler {
+public:
+    virtual ~BookScheduler() = default;
+    virtual void wakeOwner(OrderBook& book) = 0;
+    virtual void detach(OrderBook& book)    = 0;   // blocks until quiescent
+};
 
-class OrderBook {
+class OrderBook : private TimerClient {
 public:
-    explicit OrderBook(Logger* logger = nullptr)
-        : logger_(logger)
+    explicit OrderBook(int instrumentId, Logger* logger = nullptr,
+                       BookType bookType = DEFAULT_BOOK_TYPE,
+                       ExecutionMode executionMode = DEFAULT_EXECUTION_MODE)
+        : instrumentId_(instrumentId)
+        , bookType_(bookType)
+        , executionMode_(executionMode)
+        , buyLevels_(makeSide(OrderSide::BUY))
+        , sellLevels_(makeSide(OrderSide::SELL))
+        , logger_(logger)
+        , nextOrderSequence_(initialOrderSequence())
+        , nextTradeSequence_(initialOrderSequence())   // same restart-safe seeding
         , totalVolume_(0), buyVolume_(0), sellVolume_(0), tradeCount_(0)
-        , expiryRunning_(true)
+        , expiryWheel_(TimerService::nowTick())
+        , postedTick_(0)
     {
-        // Background thread: expire orders that remain pending for > ORDER_EXPIRY_SECONDS.
-        expiryThread_ = std::thread([this]() {
-            while (expiryRunning_.load()) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                expirePendingOrders();
-            }
-        });
+        if (executionMode_ != ExecutionMode::LOCKED)
+            commands_.reset(new MpscRing<Command, BOOK_COMMAND_RING_SIZE>());
+        if (executionMode_ == ExecutionMode::DEDICATED) {
+            matchingRunning_.store(true);
+            matchingThread_ = std::thread([this]() { runMatchingLoop(); });
+        }
+        // Expiry is driven by the engine-wide TimerService (see onTimerTick()).
+        TimerService::getInstance().subscribe(this);
     }
 
     ~OrderBook() {
-        expiryRunning_.store(false);
-        if (expiryThread_.joinable())
-            expiryThread_.join();
+        TimerService::getInstance().unsubscribe(this);
+        if (matchingThread_.joinable()) {
+            matchingRunning_.store(false);
+            wakeMatchingThread();
+            matchingThread_.join();
+        }
+        if (executionMode_ == ExecutionMode::POOLED) {
+            if (scheduler_) scheduler_->detach(*this);
+            while (pollCommands()) {}   // nobody else consumes now
+        }
     }
 
-    const std::map<double, std::shared_ptr<PriceLevel>, std::greater<double>>& getBuyLevels() const {
-        return reinterpret_cast<const std::map<double, std::shared_ptr<PriceLevel>, std::greater<double>>&>(buyLevels_);
+    // Invoked (under the book mutex) for every order event the book logs:
+    // the incoming order after matching, resting orders on each fill, and
+    // cancels/expiries.  Both records are only valid for the duration of the
+    // call — copy what you need and do not call back into this book.
+    using OrderListener = std::function<void(const Order&, const OrderDetails&)>;
+    void setOrderListener(OrderListener listener) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        orderListener_ = std::move(listener);
     }
-    const std::map<double, std::shared_ptr<PriceLevel>>& getSellLevels() const {
-        return sellLevels_;
+
+    // Invoked (under the book mutex) with every market-data event when the
+    // batch that produced it is published — the batch's L2 events in
+    // sequence order, then its L3 events — e.g. to record the feed for
+    // replay.  Same rules as OrderListener.
+    using MarketDataListener = std::function<void(const MarketDataEvent&)>;
+    void setMarketDataListener(MarketDataListener listener) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        marketDataListener_ = std::move(listener);
     }
 
-    void addOrder(std::shared_ptr<Order> order) {
-        if (order->getSide() == OrderSide::BUY) {
-            matchOrder(order, sellLevels_, buyLevels_);
-        } else {
-            matchOrder(order, buyLevels_, sellLevels_);
+    // ── Market data (lock-free) ───────────────────────────────────────────────
+    // The book republishes its top of book and top BOOK_SNAPSHOT_DEPTH levels
+    // per side after every batch of changes; readers copy the latest
+    // publication without touching mutex_ or the level containers.  Prices
+    // are in ticks; use getInstrument().toPrice() to render one in rupees.
+    TopOfBook    getTopOfBook()     const { return topOfBook_.load(); }
+    BookSnapshot getDepthSnapshot() const { return depth_.load(); }
+
+    // Incremental L2 feed: every level change and trade, sequenced per book.
+    // Events are appended together with the snapshot publication, so a
+    // consumer can start from getDepthSnapshot() and apply readSince() its
+    // feedSequence.
+    const MarketDataJournal& getMarketDataFeed() const { return feed_; }
+
+    // Order-by-order (L3) feed, and a full image of the resting orders to
+    // start it from.  The image is built under the book mutex.
+    const MarketDataJournal& getOrderFeed() const { return orderFeed_; }
+
+    OrderBookImage getOrderBookImage() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        OrderBookImage image;
+        image.sequence = orderFeedSequence_;
+        image.orders.reserve(orderIndex_.size());
+        for (const BookSide* side : {buyLevels_.get(), sellLevels_.get()}) {
+            side->forEachLevel([&](const PriceLevel& level) {
+                level.forEachOrder([&](const Order& order) {
+                    image.orders.push_back(MarketDataEvent{
+                        MarketDataEvent::ORDER_ADD, order.getSide(), instrumentId_, 0,
+                        order.getPriceTicks(), order.getRemainingQuantity(), 0, 0,
+                        order.getOrderId()});
+                });
+                return true;
+            });
+        }
+        return image;
+    }
+
+    BookType getBookType() const { return bookType_; }
+    int getInstrumentId() const { return instrumentId_; }
+    const Instrument& getInstrument() const {
+        return *InstrumentManager::getInstance().getInstrumentById(instrumentId_);
+    }
+
+    ExecutionMode getExecutionMode() const { return executionMode_; }
+
+    // ── Order entry ───────────────────────────────────────────────────────────
+    // submitOrder()/submitCancel()/submitAmend() never wait for the book: in
+    // DEDICATED and POOLED mode they enqueue a command for the matching thread
+    // (yielding only while the ring is full) and `done` fires once it has
+    // run and its batch has been published (snapshot, feeds, log rows).  In
+    // LOCKED mode they run on the calling thread.  addOrder()/
+    // cancelOrder()/amendOrder() are the blocking forms for callers that need
+    // the result.
+    void submitOrder(const OrderRequest& request, OrderAckCallback done = {}) {
+        if (!commands_) {
+            OrderAck ack = addOrder(request);
+            if (done) done(ack);
+            return;
         }
+        Command cmd;
+        cmd.kind     = Command::ADD;
+        cmd.request  = request;
+        cmd.onAck    = std::move(done);
+        enqueue(std::move(cmd));
     }
 
-    void cancelOrder(const std::string& orderId) {
+    void submitCancel(OrderId orderId, CancelResultCallback done = {}) {
+        if (!commands_) {
+            bool cancelled = cancelOrder(orderId);
+            if (done) done(cancelled);
+            return;
+        }
+        Command cmd;
+        cmd.kind     = Command::CANCEL;
+        cmd.orderId  = orderId;
+        cmd.onCancel = std::move(done);
+        enqueue(std::move(cmd));
+    }
+
+    void submitAmend(OrderId orderId, Price newPrice, size_t newQuantity,
+                     AmendResultCallback done = {}) {
+        if (!commands_) {
+            std::optional<OrderAck> ack = amendOrder(orderId, newPrice, newQuantity);
+            if (done) done(ack);
+            return;
+        }
+        Command cmd;
+        cmd.kind          = Command::AMEND;
+        cmd.orderId       = orderId;
+        cmd.amendPrice    = newPrice;
+        cmd.amendQuantity = newQuantity;
+        cmd.onAmend       = std::move(done);
+        enqueue(std::move(cmd));
+    }
+
+    // Match `request` against the book, rest any remainder, and log the
+    // incoming order's resulting state.  Orders that do not rest go straight
+    // back to the pool: filled ones, and MARKET / IOC / FOK orders, whose
+    // unfilled remainder is cancelled.  STOP / STOP_LIMIT orders are parked
+    // until the last trade price reaches their stopPrice; every trade fires
+    // the stops it reaches before the call returns.  A GTT order whose
+    // expireAt is unset or not after its arrival is cancelled untouched.
+    OrderAck addOrder(const OrderRequest& request) {
+        if (commands_) {
+            // The matching thread owns the promise until set_value() returns.
+            auto result = std::make_shared<std::promise<OrderAck>>();
+            std::future<OrderAck> ack = result->get_future();
+            submitOrder(request, [result](const OrderAck& a) { result->set_value(a); });
+            return ack.get();
+        }
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = orderMap_.find(orderId);
-        if (it == orderMap_.end()) return;
-        auto order = it->second;
-        if (!order) { orderMap_.erase(it); return; }
-        if (order->getStatus() == OrderStatus::CANCELLED ||
-            order->getStatus() == OrderStatus::FILLED   ||
-            order->getStatus() == OrderStatus::EXPIRED) return;
-        removeOrderFromBook(order);
-        order->cancel();
+        OrderAck ack = executeAdd(request);
+        runPostedTimers();
+        endBatch();
+        return ack;
     }
 
-    std::vector<Trade> getRecentTrades() const {
+    // Returns false if the order is unknown or no longer resting.  Logs the
+    // CANCELLED event itself.
+    bool cancelOrder(OrderId orderId) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<bool>>();
+            std::future<bool> cancelled = result->get_future();
+            submitCancel(orderId, [result](bool c) { result->set_value(c); });
+            return cancelled.get();
+        }
         std::lock_guard<std::mutex> lock(mutex_);
-        return recentTrades_;
+        bool cancelled = executeCancel(orderId);
+        runPostedTimers();
+        endBatch();
+        return cancelled;
+    }
+
+    // ── Batch entry ───────────────────────────────────────────────────────────
+    // Many orders (or cancels) in one critical section: the book is acquired
+    // once, market data is published once and every log row of the batch
+    // reaches the Logger in a single write.  Requests run in order with
+    // nothing interleaved; results come back in the same order.
+    void submitOrders(std::vector<OrderRequest> requests, OrderBatchCallback done = {}) {
+        if (!commands_) {
+            std::vector<OrderAck> acks = addOrders(requests);
+            if (done) done(acks);
+            return;
+        }
+        Command cmd;
+        cmd.kind      = Command::BATCH;
+        cmd.batchSize = requests.size();
+        cmd.batch     = [this, requests = std::move(requests), done = std::move(done),
+                         acks = std::vector<OrderAck>()](BatchStep step) mutable {
+            if (step == BatchStep::EXECUTE) acks = executeAdds(requests);
+            else if (done)                  done(acks);
+        };
+        enqueue(std::move(cmd));
+    }
+
+    void submitCancels(std::vector<OrderId> orderIds, CancelBatchCallback done = {}) {
+        if (!commands_) {
+            std::vector<bool> results = cancelOrders(orderIds);
+            if (done) done(results);
+            return;
+        }
+        Command cmd;
+        cmd.kind      = Command::BATCH;
+        cmd.batchSize = orderIds.size();
+        cmd.batch     = [this, orderIds = std::move(orderIds), done = std::move(done),
+                         results = std::vector<bool>()](BatchStep step) mutable {
+            if (step == BatchStep::EXECUTE) results = executeCancels(orderIds);
+            else if (done)                  done(results);
+        };
+        enqueue(std::move(cmd));
+    }
+
+    std::vector<OrderAck> addOrders(const std::vector<OrderRequest>& requests) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<std::vector<OrderAck>>>();
+            std::future<std::vector<OrderAck>> acks = result->get_future();
+            submitOrders(requests, [result](const std::vector<OrderAck>& a) { result->set_value(a); });
+            return acks.get();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<OrderAck> acks = executeAdds(requests);
+        runPostedTimers();
+        endBatch();
+        return acks;
+    }
+
+    std::vector<bool> cancelOrders(const std::vector<OrderId>& orderIds) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<std::vector<bool>>>();
+            std::future<std::vector<bool>> cancelled = result->get_future();
+            submitCancels(orderIds, [result](const std::vector<bool>& c) { result->set_value(c); });
+            return cancelled.get();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<bool> results = executeCancels(orderIds);
+        runPostedTimers();
+        endBatch();
+        return results;
+    }
+
+    // Change a resting order's price (ticks) and total quantity (filled +
+    // open) in one book operation, logged as a single ORDER_AMENDED event.
+    // Reducing the quantity at the same price keeps the order's time
+    // priority; a new price or a larger quantity sends it to the back of its
+    // (new) level, and a new price that crosses trades immediately, exactly
+    // like a fresh order.  Returns nullopt if the order is not resting or
+    // newQuantity does not exceed what has already been filled.
+    std::optional<OrderAck> amendOrder(OrderId orderId, Price newPrice, size_t newQuantity) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<std::optional<OrderAck>>>();
+            std::future<std::optional<OrderAck>> ack = result->get_future();
+            submitAmend(orderId, newPrice, newQuantity,
+                        [result](const std::optional<OrderAck>& a) { result->set_value(a); });
+            return ack.get();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::optional<OrderAck> ack = executeAmend(orderId, newPrice, newQuantity);
+        runPostedTimers();
+        endBatch();
+        return ack;
+    }
+
+    // ── Mass quote ────────────────────────────────────────────────────────────
+    // Replace `quote.trader`'s quote in this book in one critical section.
+    // The book remembers which resting order fills each of the trader's
+    // slots; a slot that is still resting is amended in place (same price,
+    // smaller size keeps queue priority; otherwise it moves to the back of
+    // its new level), one that has traded away is re-entered as a fresh DAY
+    // LIMIT order, and a slot beyond the new quote's depth is cancelled.
+    // Each slot logs one row and publishes once with the batch.  The side
+    // moving away from the trader's other side is updated first so a shifted
+    // quote never trades against itself; a quote that is crossed in itself,
+    // or has a non-positive price, is rejected untouched.
+    void submitMassQuote(MassQuote quote, MassQuoteCallback done = {}) {
+        if (!commands_) {
+            std::vector<OrderAck> acks = massQuote(quote);
+            if (done) done(acks);
+            return;
+        }
+        Command cmd;
+        cmd.kind      = Command::BATCH;
+        cmd.batchSize = quote.bids.size() + quote.asks.size();
+        cmd.batch     = [this, quote = std::move(quote), done = std::move(done),
+                         acks = std::vector<OrderAck>()](BatchStep step) mutable {
+            if (step == BatchStep::EXECUTE) acks = executeMassQuote(quote);
+            else if (done)                  done(acks);
+        };
+        enqueue(std::move(cmd));
+    }
+
+    std::vector<OrderAck> massQuote(const MassQuote& quote) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<std::vector<OrderAck>>>();
+            std::future<std::vector<OrderAck>> acks = result->get_future();
+            submitMassQuote(quote, [result](const std::vector<OrderAck>& a) { result->set_value(a); });
+            return acks.get();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<OrderAck> acks = executeMassQuote(quote);
+        runPostedTimers();
+        endBatch();
+        return acks;
+    }
+
+    // ── Mass cancel ───────────────────────────────────────────────────────────
+    // Cancel every resting order of `trader` in this book (only those on
+    // `side`, if given) in one critical section, each logged as CANCELLED.
+    // Walks the trader's own orders via traderOrders_, so the cost is
+    // independent of the size of the book.  Returns how many were cancelled.
+    void submitMassCancel(TraderIndex trader, std::optional<OrderSide> side = std::nullopt,
+                          MassCancelCallback done = {}) {
+        if (!commands_) {
+            size_t cancelled = massCancel(trader, side);
+            if (done) done(cancelled);
+            return;
+        }
+        Command cmd;
+        cmd.kind      = Command::BATCH;
+        cmd.batchSize = 1;
+        cmd.batch     = [this, trader, side, done = std::move(done),
+                         cancelled = size_t(0)](BatchStep step) mutable {
+            if (step == BatchStep::EXECUTE) cancelled = executeMassCancel(trader, side);
+            else if (done)                  done(cancelled);
+        };
+        enqueue(std::move(cmd));
+    }
+
+    size_t massCancel(TraderIndex trader, std::optional<OrderSide> side = std::nullopt) {
+        if (commands_) {
+            auto result = std::make_shared<std::promise<size_t>>();
+            std::future<size_t> cancelled = result->get_future();
+            submitMassCancel(trader, side, [result](size_t c) { result->set_value(c); });
+            return cancelled.get();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t cancelled = executeMassCancel(trader, side);
+        runPostedTimers();
+        endBatch();
+        return cancelled;
     }
 
-    double getBestBidPrice() const {
+    size_t getRestingOrderCount() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return buyLevels_.empty() ? 0.0 : buyLevels_.rbegin()->first;
+        return orderIndex_.size();
     }
 
-    double getBestAskPrice() const {
+    // STOP / STOP_LIMIT orders waiting for their trigger.
+    size_t getParkedStopCount() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return sellLevels_.empty() ? 0.0 : sellLevels_.begin()->first;
+        return stopBook_.size();
     }
 
+    std::vector<Trade> getRecentTrades() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return recentTrades_;
+    }
+
+    // Best prices in ticks (0 when the side is empty).
+    Price getBestBidTicks() const { return topOfBook_.load().bidPrice; }
+    Price getBestAskTicks() const { return topOfBook_.load().askPrice; }
+
+    // Best prices in rupees for display / JSON (0.0 when the side is empty).
+    double getBestBidPrice() const { return getInstrument().toPrice(getBestBidTicks()); }
+    double getBestAskPrice() const { return getInstrument().toPrice(getBestAskTicks()); }
+
     // Volume statistics (lock-free atomics)
     size_t getTotalVolume()     const { return totalVolume_.load(); }
     size_t getTotalBuyVolume()  const { return buyVolume_.load();   }
@@ -88,96 +505,205 @@ public:
     size_t getTotalTradeCount() const { return tradeCount_.load();  }
 
 private:
-    void matchOrder(std::shared_ptr<Order> incomingOrder,
-                    std::map<double, std::shared_ptr<PriceLevel>>& oppositeSide,
-                    std::map<double, std::shared_ptr<PriceLevel>>& sameSide) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<BookSide> makeSide(OrderSide side) const {
+        if (bookType_ == BookType::LADDER) {
+            const Instrument& instrument = getInstrument();
+            size_t span = static_cast<size_t>(
+                2.0 * LADDER_SPAN_FRACTION * instrument.marketPrice / instrument.tickSize);
+            return std::make_unique<LadderBookSide>(
+                side, instrument.toTicks(instrument.marketPrice),
+                std::min(span, LADDER_MAX_WINDOW));
+        }
+        return std::make_unique<MapBookSide>(side);
+    }
 
-        bool isFullyMatched = false;
-        while (!oppositeSide.empty() && !isFullyMatched) {
-            auto bestPrice = (incomingOrder->getSide() == OrderSide::BUY) ?
-                             oppositeSide.begin()->first : oppositeSide.rbegin()->first;
+    // Lock-free: a single fetch_add on the book's sequence counter.
+    OrderId nextOrderId() {
+        return makeOrderId(instrumentId_,
+                           nextOrderSequence_.fetch_add(1, std::memory_order_relaxed));
+    }
 
-            if ((incomingOrder->getSide() == OrderSide::BUY  && bestPrice > incomingOrder->getPrice()) ||
-                (incomingOrder->getSide() == OrderSide::SELL && bestPrice < incomingOrder->getPrice()))
-                break;
+    // Returns true if the incoming order's remainder was rested (reported on
+    // the L3 feed as `restEvent`).  MARKET orders (and triggered STOPs)
+    // ignore their price and sweep until filled or the opposite side is
+    // empty; they, IOC and FOK orders never rest.  An FOK order that cannot
+    // fill completely does not trade at all.  `expiryScheduled` is set for
+    // an order that already has its (unchanged) expiry on the wheel.
+    bool matchOrder(Order& incomingOrder,
+                    BookSide& oppositeSide,
+                    BookSide& sameSide,
+                    MarketDataEvent::Kind restEvent = MarketDataEvent::ORDER_ADD,
+                    bool expiryScheduled = false) {
+        // Re-centre LADDER windows on the book's own last trade price (the
+        // window starts centred on the instrument's price at construction);
+        // Instrument::marketPrice is display state written by other threads.
+        if (bookType_ == BookType::LADDER && lastTradePrice_ != 0) {
+            oppositeSide.track(lastTradePrice_);
+            sameSide.track(lastTradePrice_);
+        }
 
-            auto priceLevel = (incomingOrder->getSide() == OrderSide::BUY) ?
-                              oppositeSide.begin()->second : oppositeSide.rbegin()->second;
+        const bool isMarket = incomingOrder.getType() == OrderType::MARKET ||
+                              incomingOrder.getType() == OrderType::STOP;
+        if (incomingOrder.getTimeInForce() == TimeInForce::FOK &&
+            fillableQuantity(incomingOrder, oppositeSide) < incomingOrder.getRemainingQuantity())
+            return false;
 
-            while (!priceLevel->isEmpty() && incomingOrder->getRemainingQuantity() > 0) {
-                auto restingOrder = priceLevel->getFirstOrder();
-                if (!restingOrder) break; // defensive: price level should not yield null while !isEmpty()
-                auto matchQty = std::min(incomingOrder->getRemainingQuantity(),
+        bool isFullyMatched = false;
+        while (!isFullyMatched) {
+            PriceLevel* priceLevel = oppositeSide.best();
+            if (!priceLevel) break;
+            const Price bestPrice = priceLevel->getPrice();
+
+            if (!isMarket && oppositeSide.isBetter(incomingOrder.getPriceTicks(), bestPrice))
+                break; // best resting price is worse than the incoming limit
+
+            while (!priceLevel->isEmpty() && incomingOrder.getRemainingQuantity() > 0) {
+                Order* restingOrder = priceLevel->getFirstOrder();
+                auto matchQty = std::min(incomingOrder.getRemainingQuantity(),
                                          restingOrder->getRemainingQuantity());
-                executeTrade(incomingOrder, restingOrder, matchQty, bestPrice);
-                if (restingOrder->getRemainingQuantity() == 0) removeOrderFromBook(restingOrder);
-                if (incomingOrder->getRemainingQuantity() == 0) { isFullyMatched = true; break; }
+                executeTrade(incomingOrder, *restingOrder, matchQty, bestPrice);
+                // Keep the level alive while we are still walking it; it is
+                // dropped below once empty.
+                if (restingOrder->getRemainingQuantity() == 0) {
+                    removeOrderFromBook(*restingOrder, /*dropEmptyLevel=*/false);
+                    pool_.release(restingOrder);
+                } else {
+                    levelChanged(oppositeSide, *priceLevel);
+                }
+                if (incomingOrder.getRemainingQuantity() == 0) { isFullyMatched = true; break; }
             }
 
-            if (priceLevel->isEmpty()) oppositeSide.erase(bestPrice);
+            if (priceLevel->isEmpty()) dropLevel(oppositeSide, bestPrice);
         }
 
-        if (!isFullyMatched && incomingOrder->getTimeInForce() != TimeInForce::IOC)
-            addToBook(incomingOrder, sameSide);
+        if (isFullyMatched || isMarket ||
+            incomingOrder.getTimeInForce() == TimeInForce::IOC ||
+            incomingOrder.getTimeInForce() == TimeInForce::FOK)
+            return false;
+        addToBook(incomingOrder, sameSide, restEvent, expiryScheduled);
+        return true;
     }
 
-    void addToBook(std::shared_ptr<Order> order,
-                   std::map<double, std::shared_ptr<PriceLevel>>& side) {
-        auto price = order->getPrice();
-        auto& priceLevel = side[price];
-        if (!priceLevel) priceLevel = std::make_shared<PriceLevel>(price);
-        priceLevel->addOrder(order);
-        orderMap_[order->getOrderId()] = order;
+    // Quantity `order` could take from `oppositeSide` right now, counted from
+    // the level aggregates (no order is visited) and capped at what it needs.
+    size_t fillableQuantity(const Order& order, const BookSide& oppositeSide) const {
+        const bool   isMarket = order.getType() == OrderType::MARKET ||
+                                order.getType() == OrderType::STOP;
+        const size_t needed   = order.getRemainingQuantity();
+        size_t       fillable = 0;
+        oppositeSide.forEachLevel([&](const PriceLevel& level) {
+            if (!isMarket && oppositeSide.isBetter(order.getPriceTicks(), level.getPrice()))
+                return false;
+            fillable += level.getTotalQuantity();
+            return fillable < needed;
+        });
+        return std::min(fillable, needed);
     }
 
-    void removeOrderFromBook(std::shared_ptr<Order> order) {
-        auto price = order->getPrice();
-        auto& side = (order->getSide() == OrderSide::BUY) ? buyLevels_ : sellLevels_;
-        auto it = side.find(price);
-        if (it != side.end()) {
-            it->second->removeOrder(order->getOrderId());
-            if (it->second->isEmpty()) side.erase(it);
+    void addToBook(Order& order, BookSide& side, MarketDataEvent::Kind restEvent,
+                   bool expiryScheduled) {
+        PriceLevel& level = side.findOrCreate(order.getPriceTicks());
+        level.addOrder(&order);
+        levelChanged(side, level);
+        emitOrder(restEvent, order, order.getRemainingQuantity());
+        orderIndex_.insert(order.getOrderId(), order.getPoolHandle());
+        traderOrders_.link(pool_, order.getPoolHandle());
+        if (!expiryScheduled) scheduleExpiry(order);
+    }
+
+    // Unlink from its level in O(1) via the order's back-pointer and drop it
+    // from orderIndex_ and traderOrders_.  The slot stays live; the caller
+    // releases it to pool_.
+    void removeOrderFromBook(Order& order, bool dropEmptyLevel = true) {
+        if (PriceLevel* level = order.getLevel()) {
+            BookSide& side = (order.getSide() == OrderSide::BUY) ? *buyLevels_ : *sellLevels_;
+            level->removeOrder(&order);
+            if (level->isEmpty()) {
+                if (dropEmptyLevel) dropLevel(side, level->getPrice());
+            } else {
+                levelChanged(side, *level);
+            }
         }
-        orderMap_.erase(order->getOrderId());
+        orderIndex_.erase(order.getOrderId());
+        traderOrders_.unlink(pool_, order.getPoolHandle());
     }
 
-    void executeTrade(std::shared_ptr<Order> incomingOrder,
-                      std::shared_ptr<Order> restingOrder,
-                      size_t quantity, double price) {
+    // ── Market-data bookkeeping (every level mutation goes through here) ─────
+    void levelChanged(BookSide& side, const PriceLevel& level) {
+        depthOf(side).update(level);
+        emitLevel(side.getSide(), level.getPrice(), level.getTotalQuantity(), level.getOrderCount());
+    }
+
+    void dropLevel(BookSide& side, Price price) {
+        side.removeLevel(price);
+        depthOf(side).remove(price, side);
+        emitLevel(side.getSide(), price, 0, 0);
+    }
+
+    DepthCache& depthOf(const BookSide& side) {
+        return side.getSide() == OrderSide::BUY ? buyDepth_ : sellDepth_;
+    }
+
+    void emitLevel(OrderSide side, Price price, size_t quantity, size_t orderCount) {
+        pendingEvents_.push_back(MarketDataEvent{MarketDataEvent::LEVEL, side, instrumentId_,
+                                                 ++feedSequence_, price, quantity, orderCount, 0, 0});
+    }
+
+    void emitOrder(MarketDataEvent::Kind kind, const Order& order, size_t quantity,
+                   uint64_t tradeSequence = 0) {
+        if (!MARKET_DATA_L3_ENABLED) return;
+        pendingOrderEvents_.push_back(MarketDataEvent{kind, order.getSide(), instrumentId_,
+                                                      ++orderFeedSequence_, order.getPriceTicks(),
+                                                      quantity, 0, tradeSequence, order.getOrderId()});
+    }
+
+    void executeTrade(Order& incomingOrder, Order& restingOrder,
+                      size_t quantity, Price price) {
         // ── Determine buyer / seller and aggressor side ───────────────────────
         // The INCOMING order is always the aggressor (it crossed the spread).
-        const bool incomingIsBuy = (incomingOrder->getSide() == OrderSide::BUY);
-        const std::string& buyerUserId  = incomingIsBuy
-                                              ? incomingOrder->getTraderId()
-                                              : restingOrder->getTraderId();
-        const std::string& sellerUserId = incomingIsBuy
-                                              ? restingOrder->getTraderId()
-                                              : incomingOrder->getTraderId();
-        const std::string& buyOrderId   = incomingIsBuy
-                                              ? incomingOrder->getOrderId()
-                                              : restingOrder->getOrderId();
-        const std::string& sellOrderId  = incomingIsBuy
-                                              ? restingOrder->getOrderId()
-                                              : incomingOrder->getOrderId();
-
-        // ── Build enriched Trade record FIRST — its tradeId is stamped into ──
-        //    both Order objects so that ALL subsequent logOrder() calls for the
-        //    incoming and resting orders carry real IDs (trade_id, buyer_user_id,
-        //    seller_user_id) instead of "NA", for every status event row written
-        //    to QuestDB (PARTIAL, FILLED, CANCELLED-after-partial, EXPIRED-after-partial).
-        Trade trade(buyOrderId, sellOrderId,
-                    price, quantity, std::chrono::system_clock::now(),
-                    buyerUserId, sellerUserId,
-                    incomingOrder->getSide(),          // aggressor_side
-                    incomingOrder->getInstrumentId()); // instrument_id
-
-        // ── Fill both sides, embedding Trade context into each Order ──────────
+        const bool incomingIsBuy = (incomingOrder.getSide() == OrderSide::BUY);
+        const TraderIndex  buyer        = incomingIsBuy
+                                              ? incomingOrder.getTrader()
+                                              : restingOrder.getTrader();
+        const TraderIndex  seller       = incomingIsBuy
+                                              ? restingOrder.getTrader()
+                                              : incomingOrder.getTrader();
+        const OrderId      buyOrderId   = incomingIsBuy
+                                              ? incomingOrder.getOrderId()
+                                              : restingOrder.getOrderId();
+        const OrderId      sellOrderId  = incomingIsBuy
+                                              ? restingOrder.getOrderId()
+                                              : incomingOrder.getOrderId();
+
+        // ── Build enriched Trade record FIRST — its trade sequence is stamped ─
+        //    into both OrderDetails records so that ALL subsequent logOrder()
+        //    calls for the incoming and resting orders carry real IDs (trade_id,
+        //    buyer_user_id, seller_user_id) instead of "NA", for every status event
+        //    row written to QuestDB (PARTIAL, FILLED, CANCELLED-after-partial,
+        //    EXPIRED-after-partial).
+        const Trade trade(nextTradeSequence_++, buyOrderId, sellOrderId,
+                          price, quantity, std::chrono::system_clock::now(),
+                          buyer, seller,
+                          incomingOrder.getSide(), // aggressor_side
+                          instrumentId_);
+
+        // ── Fill both sides, embedding Trade context into each OrderDetails ───
         // Any logOrder() call on these orders (now or later, e.g. expiry/cancel)
         // will write the real trade_id, buyer_user_id, seller_user_id.
-        incomingOrder->fillWithTradeContext(quantity, trade.getTradeId(), buyerUserId, sellerUserId);
-        restingOrder->fillWithTradeContext(quantity, trade.getTradeId(), buyerUserId, sellerUserId);
+        incomingOrder.fill(quantity);
+        restingOrder.fill(quantity);
+        // The level change itself is reported by matchOrder().
+        if (PriceLevel* level = restingOrder.getLevel()) level->reduceQuantity(quantity);
+        pendingEvents_.push_back(MarketDataEvent{MarketDataEvent::TRADE, incomingOrder.getSide(),
+                                                 instrumentId_, ++feedSequence_, price, quantity,
+                                                 0, trade.getTradeSequence(), 0});
+        emitOrder(MarketDataEvent::ORDER_EXECUTE, restingOrder, quantity, trade.getTradeSequence());
+        pool_.details(incomingOrder.getPoolHandle()).setTradeContext(trade.getTradeSequence(), buyer, seller);
+        pool_.details(restingOrder.getPoolHandle()).setTradeContext(trade.getTradeSequence(), buyer, seller);
 
+        lastTradePrice_ = price;
+        if (tradeLow_ == 0 || price < tradeLow_) tradeLow_ = price;
+        if (price > tradeHigh_)                   tradeHigh_ = price;
         recentTrades_.push_back(trade);
         if (recentTrades_.size() > 100) recentTrades_.erase(recentTrades_.begin());
 
@@ -187,65 +713,630 @@ private:
         if (incomingIsBuy) buyVolume_  += quantity;
         else               sellVolume_ += quantity;
 
-        if (logger_) {
-            // Log the resting order's updated status (PARTIAL or FILLED).
-            // The incoming order is logged by the caller after addOrder() returns.
-            // Both now have trade context embedded so logOrder() produces full rows.
-            logger_->logOrder(*restingOrder);
+        // Log the resting order's updated status (PARTIAL or FILLED).
+        // The incoming order is logged by addOrder() once matching finishes.
+        // Both now have trade context embedded so logOrder() produces full rows.
+        publishOrder(restingOrder);
+
+        // Log the matched TRADE_MATCH row — primary row for ML graph analysis.
+        if (logger_) logger_->appendTrade(logRows_, trade);
+    }
+
+    // Log rows are buffered in logRows_ and handed to the Logger once per
+    // critical section by endBatch().
+    void publishOrder(const Order& order, const char* logEvent = nullptr) {
+        const OrderDetails& details = pool_.details(order.getPoolHandle());
+        if (logger_) logger_->appendOrder(logRows_, order, details, logEvent);
+        if (orderListener_) orderListener_(order, details);
+    }
+
+    // ── Command execution (caller holds mutex_ / is the matching thread) ────────
+    OrderAck executeAdd(const OrderRequest& request) {
+        Order& order = *pool_.acquire(nextOrderId(), request);
+        // A GTT order must expire after it arrives (an unset expireAt is the
+        // epoch); otherwise it would trade and then vanish on the next tick.
+        if (request.timeInForce == TimeInForce::GTT
+            && request.expireAt <= pool_.details(order.getPoolHandle()).getSubmitTimestamp())
+            return rejectOrder(order);
+        OrderAck ack = (request.type == OrderType::STOP || request.type == OrderType::STOP_LIMIT)
+                           ? parkStop(order, request)
+                           : enterOrder(order);
+        fireStops();
+        return ack;
+    }
+
+    // Cancel a request that failed validation before it could touch the
+    // book, log it and hand its slot back.
+    OrderAck rejectOrder(Order& order) {
+        order.cancel();
+        pool_.details(order.getPoolHandle()).stampCancel();
+        publishOrder(order);
+        OrderAck ack{order.getOrderId(), order.getStatus(), 0, order.getRemainingQuantity(), false};
+        pool_.release(&order);
+        return ack;
+    }
+
+    // Match a newly arrived order (or a stop that just triggered), rest or
+    // cancel whatever is left, and log its resulting state — unless
+    // `logUntouched` is false and nothing happened to it (still NEW).
+    OrderAck enterOrder(Order& order, bool logUntouched = true, bool expiryScheduled = false) {
+        depthChanged_ = true;
 
-            // Log the matched TRADE_MATCH row — primary row for ML graph analysis.
-            logger_->logTrade(trade);
+        const MarketDataEvent::Kind restEvent = MarketDataEvent::ORDER_ADD;
+        bool resting = (order.getSide() == OrderSide::BUY)
+                           ? matchOrder(order, *sellLevels_, *buyLevels_, restEvent, expiryScheduled)
+                           : matchOrder(order, *buyLevels_, *sellLevels_, restEvent, expiryScheduled);
+        // Whatever could neither fill nor rest (MARKET / IOC / FOK) is cancelled.
+        if (!resting && order.getRemainingQuantity() > 0) {
+            order.cancel();
+            pool_.details(order.getPoolHandle()).stampCancel();
         }
+        if (logUntouched || order.getStatus() != OrderStatus::NEW) publishOrder(order);
+
+        OrderAck ack{order.getOrderId(), order.getStatus(),
+                     pool_.details(order.getPoolHandle()).getQuantity() - order.getRemainingQuantity(),
+                     order.getRemainingQuantity(), resting};
+        if (!resting) pool_.release(&order);
+        return ack;
+    }
+
+    // ── Stop orders ───────────────────────────────────────────────────────────
+    // A STOP / STOP_LIMIT order is logged NEW and parked in stopBook_ (and
+    // stopIndex_ / traderOrders_, so it can be cancelled or expire like a
+    // resting order) until the last trade price reaches its stop price; if
+    // it already has, it triggers on entry.  One without a positive stop
+    // price (or, for STOP_LIMIT, limit price) is cancelled at once.
+    OrderAck parkStop(Order& order, const OrderRequest& request) {
+        if (request.stopPrice <= 0 || (request.type == OrderType::STOP_LIMIT && request.price <= 0))
+            return rejectOrder(order);
+        publishOrder(order);
+        if (stopReached(order.getSide(), request.stopPrice))
+            return triggerStop(order, /*expiryScheduled=*/false);
+
+        const OrderHandle handle = order.getPoolHandle();
+        stopBook_.add(order.getSide(), request.stopPrice, handle);
+        stopIndex_.insert(order.getOrderId(), handle);
+        traderOrders_.link(pool_, handle);
+        scheduleExpiry(order);
+        return OrderAck{order.getOrderId(), OrderStatus::NEW, 0, order.getRemainingQuantity(), false};
+    }
+
+    bool stopReached(OrderSide side, Price stopPrice) const {
+        if (lastTradePrice_ == 0) return false;
+        return side == OrderSide::BUY ? lastTradePrice_ >= stopPrice : lastTradePrice_ <= stopPrice;
+    }
+
+    // Logged STOP_TRIGGERED, then enters the book as a MARKET (STOP) or
+    // LIMIT (STOP_LIMIT) order would.  A stop that was parked keeps the
+    // expiry it was given then.
+    OrderAck triggerStop(Order& order, bool expiryScheduled) {
+        publishOrder(order, "STOP_TRIGGERED");
+        return enterOrder(order, /*logUntouched=*/false, expiryScheduled);
     }
 
-    // ── Expiry: scan all pending orders and expire those older than ORDER_EXPIRY_SECONDS ──
-    void expirePendingOrders() {
-        auto now = std::chrono::system_clock::now();
-        std::vector<std::shared_ptr<Order>> toExpire;
+    // Take a parked stop out of stopIndex_ / traderOrders_ (stopBook_ is
+    // handled by the caller).  The slot stays live.
+    void unparkStop(Order& order) {
+        stopIndex_.erase(order.getOrderId());
+        traderOrders_.unlink(pool_, order.getPoolHandle());
+    }
 
+    // Caller holds mutex_; runs after every operation that can trade.
+    // Triggers every parked stop reached by any of the operation's trades —
+    // a sweep can print through a stop and away again, so buy stops are
+    // checked against the highest print and sell stops against the lowest.
+    // A triggered stop may trade and so trigger more: the cascade runs here,
+    // in rounds over each round's prints, never recursively.  Costs nothing
+    // beyond a look at each side's nearest stop when none is reached.
+    void fireStops() {
+        while (tradeLow_ != 0) {
+            const Price low = tradeLow_, high = tradeHigh_;
+            tradeLow_ = tradeHigh_ = 0;
+            if (stopBook_.empty()) return;
+            triggeredStops_.clear();
+            stopBook_.takeTriggered(low, high, triggeredStops_);
+            for (OrderHandle handle : triggeredStops_) {
+                Order& order = pool_[handle];
+                unparkStop(order);
+                triggerStop(order, /*expiryScheduled=*/true);
+            }
+        }
+    }
+
+    // Cancel (or expire) a parked stop; false if `orderId` is not one.
+    bool removeStop(OrderId orderId, bool expired) {
+        const OrderHandle handle = stopIndex_.find(orderId);
+        if (handle == INVALID_ORDER_HANDLE) return false;
+        Order* order = &pool_[handle];
+        stopBook_.remove(order->getSide(), pool_.details(handle).getStopPrice(), handle);
+        unparkStop(*order);
+        if (expired) {
+            order->expire();
+        } else {
+            order->cancel();
+            pool_.details(handle).stampCancel();
+        }
+        publishOrder(*order);
+        pool_.release(order);
+        return true;
+    }
+
+    std::vector<OrderAck> executeAdds(const std::vector<OrderRequest>& requests) {
+        std::vector<OrderAck> acks;
+        acks.reserve(requests.size());
+        for (const OrderRequest& request : requests) acks.push_back(executeAdd(request));
+        return acks;
+    }
+
+    std::vector<bool> executeCancels(const std::vector<OrderId>& orderIds) {
+        std::vector<bool> results;
+        results.reserve(orderIds.size());
+        for (OrderId orderId : orderIds) results.push_back(executeCancel(orderId));
+        return results;
+    }
+
+    bool executeCancel(OrderId orderId) {
+        const OrderHandle handle = orderIndex_.find(orderId);
+        if (handle == INVALID_ORDER_HANDLE) return removeStop(orderId, /*expired=*/false);
+        Order* order = &pool_[handle];
+        emitOrder(MarketDataEvent::ORDER_DELETE, *order, order->getRemainingQuantity());
+        removeOrderFromBook(*order);
+        depthChanged_ = true;
+        order->cancel();
+        pool_.details(handle).stampCancel();
+        publishOrder(*order);
+        pool_.release(order);
+        return true;
+    }
+
+    std::optional<OrderAck> executeAmend(OrderId orderId, Price newPrice, size_t newQuantity) {
+        const OrderHandle handle = orderIndex_.find(orderId);
+        if (handle == INVALID_ORDER_HANDLE) return std::nullopt;
+        Order* order = &pool_[handle];
+        OrderDetails& details = pool_.details(handle);
+        const size_t filled = details.getQuantity() - order->getRemainingQuantity();
+        if (newPrice <= 0 || newQuantity <= filled) return std::nullopt;
+        const size_t newRemaining = newQuantity - filled;
+
+        const bool isBuy = order->getSide() == OrderSide::BUY;
+        BookSide& sameSide     = isBuy ? *buyLevels_  : *sellLevels_;
+        BookSide& oppositeSide = isBuy ? *sellLevels_ : *buyLevels_;
+        bool resting = true;
+
+        if (newPrice == order->getPriceTicks() && newRemaining == order->getRemainingQuantity()) {
+            // Nothing to change.
+        } else if (newPrice == order->getPriceTicks() && newRemaining < order->getRemainingQuantity()) {
+            // Quantity down in place: the order keeps its queue position.
+            PriceLevel* level = order->getLevel();
+            level->reduceQuantity(order->getRemainingQuantity() - newRemaining);
+            order->amend(newPrice, newRemaining);
+            details.setQuantity(newQuantity);
+            levelChanged(sameSide, *level);
+            emitOrder(MarketDataEvent::ORDER_AMEND, *order, newRemaining);
+            publishOrder(*order, "ORDER_AMENDED");
+            depthChanged_ = true;
+        } else {
+            // Cancel/replace without the round trip: leave the level, then
+            // re-enter at the new price as if just arrived (it may cross).
+            removeOrderFromBook(*order);
+            order->amend(newPrice, newRemaining);
+            details.setQuantity(newQuantity);
+            publishOrder(*order, "ORDER_AMENDED");
+            // Its expiry is unchanged and still on the wheel: don't add another.
+            resting = matchOrder(*order, oppositeSide, sameSide, MarketDataEvent::ORDER_AMEND,
+                                 /*expiryScheduled=*/true);
+            if (!resting) emitOrder(MarketDataEvent::ORDER_AMEND, *order, 0);
+            if (order->getRemainingQuantity() != newRemaining) publishOrder(*order);   // it traded
+            depthChanged_ = true;
+        }
+
+        OrderAck ack{orderId, order->getStatus(), newQuantity - order->getRemainingQuantity(),
+                     order->getRemainingQuantity(), resting};
+        if (!resting) pool_.release(order);
+        fireStops();
+        return ack;
+    }
+
+    size_t executeMassCancel(TraderIndex trader, std::optional<OrderSide> side) {
+        size_t cancelled = 0;
+        traderOrders_.forEach(pool_, trader, [&](OrderHandle handle) {
+            const Order& order = pool_[handle];
+            if (side && order.getSide() != *side) return;
+            if (executeCancel(order.getOrderId())) ++cancelled;
+        });
+        return cancelled;
+    }
+
+    // Resting orders currently standing for one trader's quote slots (0 = empty).
+    struct QuoteSlots {
+        std::vector<OrderId> bids;
+        std::vector<OrderId> asks;
+    };
+
+    std::vector<OrderAck> executeMassQuote(const MassQuote& quote) {
+        Price highestBid = 0, lowestAsk = 0;
+        for (const QuoteLevel& level : quote.bids) {
+            if (level.quantity == 0) continue;
+            if (level.price <= 0) return {};
+            highestBid = std::max(highestBid, level.price);
+        }
+        for (const QuoteLevel& level : quote.asks) {
+            if (level.quantity == 0) continue;
+            if (level.price <= 0) return {};
+            if (lowestAsk == 0 || level.price < lowestAsk) lowestAsk = level.price;
+        }
+        if (highestBid > 0 && lowestAsk > 0 && highestBid >= lowestAsk) return {};
+
+        QuoteSlots& slots = quotes_[quote.trader];
+        std::vector<OrderAck> acks;
+        acks.reserve(quote.bids.size() + quote.asks.size());
+        // Moving up: the new bids could reach the old asks, so move those first.
+        const Price ownAsk = bestQuoted(slots.asks, OrderSide::SELL);
+        if (highestBid > 0 && ownAsk > 0 && highestBid >= ownAsk) {
+            std::vector<OrderAck> askAcks;
+            applyQuoteSide(quote.trader, OrderSide::SELL, quote.asks, slots.asks, askAcks);
+            applyQuoteSide(quote.trader, OrderSide::BUY, quote.bids, slots.bids, acks);
+            acks.insert(acks.end(), askAcks.begin(), askAcks.end());
+        } else {
+            applyQuoteSide(quote.trader, OrderSide::BUY, quote.bids, slots.bids, acks);
+            applyQuoteSide(quote.trader, OrderSide::SELL, quote.asks, slots.asks, acks);
+        }
+        if (slots.bids.empty() && slots.asks.empty()) quotes_.erase(quote.trader);
+        return acks;
+    }
+
+    // Best price among the slots that are still resting (0 if none).
+    Price bestQuoted(const std::vector<OrderId>& slots, OrderSide side) const {
+        Price best = 0;
+        for (OrderId orderId : slots) {
+            const OrderHandle handle = orderIndex_.find(orderId);
+            if (handle == INVALID_ORDER_HANDLE) continue;
+            const Price price = pool_[handle].getPriceTicks();
+            if (best == 0 || (side == OrderSide::BUY ? price > best : price < best)) best = price;
+        }
+        return best;
+    }
+
+    void applyQuoteSide(TraderIndex trader, OrderSide side,
+                        const std::vector<QuoteLevel>& levels,
+                        std::vector<OrderId>& slots,
+                        std::vector<OrderAck>& acks) {
+        for (size_t i = levels.size(); i < slots.size(); ++i)
+            if (slots[i] != 0) executeCancel(slots[i]);
+        slots.resize(levels.size(), 0);
+
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const QuoteLevel& level = levels[i];
+            if (level.quantity == 0) {
+                if (slots[i] != 0) executeCancel(slots[i]);
+                slots[i] = 0;
+                acks.push_back(OrderAck{0, OrderStatus::CANCELLED, 0, 0, false});
+                continue;
+            }
+            std::optional<OrderAck> ack;
+            const OrderHandle handle = slots[i] != 0 ? orderIndex_.find(slots[i]) : INVALID_ORDER_HANDLE;
+            if (handle != INVALID_ORDER_HANDLE) {
+                // amend takes the total quantity: keep what has filled, quote the rest.
+                const Order& order  = pool_[handle];
+                const size_t filled = pool_.details(handle).getQuantity() - order.getRemainingQuantity();
+                ack = executeAmend(slots[i], level.price, filled + level.quantity);
+            }
+            if (!ack)
+                ack = executeAdd(OrderRequest{OrderType::LIMIT, side, level.price, level.quantity,
+                                              TimeInForce::DAY, trader, instrumentId_});
+            slots[i] = ack->resting ? ack->orderId : 0;
+            acks.push_back(*ack);
+        }
+        while (!slots.empty() && slots.back() == 0) slots.pop_back();
+    }
+
+    // ── DEDICATED execution ───────────────────────────────────────────────────
+    // A BATCH command's closure runs twice: EXECUTE under the book, keeping
+    // its results, then COMPLETE once they are published, to report them.
+    enum class BatchStep { EXECUTE, COMPLETE };
+
+    struct Command {
+        enum Kind { ADD, CANCEL, AMEND, BATCH } kind = ADD;
+        OrderRequest         request{};
+        OrderId              orderId       = 0;
+        Price                amendPrice    = 0;
+        size_t               amendQuantity = 0;
+        OrderAckCallback     onAck;
+        CancelResultCallback onCancel;
+        AmendResultCallback  onAmend;
+        std::function<void(BatchStep)> batch;       // BATCH: runs the whole batch
+        size_t               batchSize     = 0;     // BATCH: requests in it
+    };
+
+    void enqueue(Command&& cmd) {
+        while (!commands_->tryPush(std::move(cmd))) std::this_thread::yield();
+        notifyConsumer();
+    }
+
+    // After posting work (a command or a timer tick).  Pairs with the fence a
+    // consumer issues before parking: either it sees the work before it
+    // parks, or we see it parked and wake it.
+    void notifyConsumer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (scheduler_) scheduler_->wakeOwner(*this);
+        else if (matchingParked_.load(std::memory_order_relaxed)) wakeMatchingThread();
+    }
+
+    void wakeMatchingThread() {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        parkCv_.notify_one();
+    }
+
+    // A command that has run but whose caller has not been told yet.
+    struct Completion {
+        Command                 cmd;
+        OrderAck                ack{};        // ADD
+        bool                    cancelled = false;   // CANCEL
+        std::optional<OrderAck> amended;      // AMEND
+    };
+
+    // Runs `cmd` and parks it in completions_; its callback fires from
+    // complete() once the batch has been published.  Returns how many
+    // requests the command carried (the pool's load metric).
+    size_t execute(Command& cmd) {
+        Completion& done = completions_.emplace_back();
+        size_t requests = 1;
+        if (cmd.kind == Command::BATCH) {
+            cmd.batch(BatchStep::EXECUTE);
+            requests = cmd.batchSize;
+        } else if (cmd.kind == Command::ADD) {
+            done.ack = executeAdd(cmd.request);
+        } else if (cmd.kind == Command::CANCEL) {
+            done.cancelled = executeCancel(cmd.orderId);
+        } else {
+            done.amended = executeAmend(cmd.orderId, cmd.amendPrice, cmd.amendQuantity);
+        }
+        done.cmd = std::move(cmd);
+        return requests;
+    }
+
+    // After endBatch(): acks and futures never run ahead of the published
+    // snapshot, feeds and log rows.  Runs without mutex_, so a callback may
+    // read this book (resting count, recent trades, ...) without deadlocking.
+    void complete() {
+        for (Completion& done : completing_) {
+            Command& cmd = done.cmd;
+            if (cmd.kind == Command::BATCH)                 cmd.batch(BatchStep::COMPLETE);
+            else if (cmd.kind == Command::ADD && cmd.onAck) cmd.onAck(done.ack);
+            else if (cmd.kind == Command::CANCEL && cmd.onCancel) cmd.onCancel(done.cancelled);
+            else if (cmd.kind == Command::AMEND && cmd.onAmend)   cmd.onAmend(done.amended);
+        }
+        completing_.clear();
+    }
+
+    // Consumer side, called only by the book's current consumer (its matching
+    // thread or owning MatchingPool worker).  Producers never touch mutex_;
+    // the consumer takes it once per batch, uncontended except by the odd
+    // locked reader (recent trades, resting count).  Posted timer ticks run
+    // after the batch, then market data is republished, and only then, with
+    // mutex_ released, are the batch's callers told (complete()).  Returns
+    // false if there was nothing to do.
+    bool pollCommands() {
+        const bool haveCommand = commands_->tryPop(polled_);
+        if (!haveCommand && !timerDue()) return false;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            for (auto& kv : orderMap_) {
-                auto& order = kv.second;
-                if (!order) continue;
-                auto status = order->getStatus();
-                if (status != OrderStatus::NEW && status != OrderStatus::PARTIALLY_FILLED)
-                    continue;
-                auto ageSec = std::chrono::duration_cast<std::chrono::seconds>(
-                    now - order->getTimestamp()).count();
-                if (ageSec >= ORDER_EXPIRY_SECONDS)
-                    toExpire.push_back(order);
-            }
-            // Remove expired orders from price levels and orderMap_
-            for (auto& order : toExpire) {
-                removeOrderFromBook(order);
-                order->expire();
+            if (haveCommand) {
+                size_t n = 0, requests = 0;
+                do { requests += execute(polled_); } while (++n < BOOK_COMMAND_BATCH && commands_->tryPop(polled_));
+                commandsExecuted_.fetch_add(requests, std::memory_order_relaxed);
             }
+            runPostedTimers();
+            endBatch();
+            completing_.swap(completions_);
         }
+        complete();
+        return true;
+    }
+
+    bool timerDue() const {
+        return postedTick_.load(std::memory_order_acquire) >= expiryWheel_.current();
+    }
+    bool hasPendingWork() const { return !commands_->empty() || timerDue(); }
+
+    // The only thread that mutates a DEDICATED book.  On shutdown, queued
+    // commands are drained so no caller is left waiting on a future.
+    void runMatchingLoop() {
+        ThreadTuning& tuning = ThreadTuning::getInstance();
+        tuning.pin(ThreadRole::MATCHING);
+        unsigned idlePolls = 0;
+        for (;;) {
+            if (pollCommands()) { idlePolls = 0; continue; }
+            if (!matchingRunning_.load()) break;
+            if (tuning.keepSpinning(idlePolls++)) { cpuRelax(); continue; }
+            // Idle: park until a producer or the TimerService wakes us (the
+            // timeout is only a backstop).
+            std::unique_lock<std::mutex> lock(parkMutex_);
+            matchingParked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!hasPendingWork() && matchingRunning_.load())
+                parkCv_.wait_for(lock, std::chrono::milliseconds(TIMER_WHEEL_TICK_MS));
+            matchingParked_.store(false, std::memory_order_relaxed);
+            idlePolls = 0;
+        }
+    }
+
+    // ── Timers / expiry ───────────────────────────────────────────────────────
+    // The TimerService thread never waits for the book: it posts the tick to
+    // the book's execution context.  DEDICATED and POOLED books run it on
+    // their consumer thread (woken if parked).  In LOCKED mode the context is whoever holds
+    // mutex_: the service runs the timers itself only if the book is idle,
+    // otherwise the current holder drains the posted tick in
+    // runPostedTimers() before it returns (at worst a tick that races the
+    // holder's unlock is picked up one tick later).
+    void onTimerTick(uint64_t nowTick) override {
+        postedTick_.store(nowTick, std::memory_order_release);
+        if (commands_) {
+            notifyConsumer();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            runPostedTimers();
+            endBatch();
+        }
+    }
 
-        // Log EXPIRED status to QuestDB outside the book mutex
-        if (logger_) {
-            for (auto& order : toExpire) {
-                logger_->logOrder(*order);
+    static std::chrono::system_clock::time_point
+    sessionCloseAfter(std::chrono::system_clock::time_point tp) {
+        using namespace std::chrono;
+        const auto secs  = duration_cast<seconds>(tp.time_since_epoch()).count();
+        auto       close = secs - secs % 86400 + SESSION_CLOSE_UTC_SECONDS;
+        if (close <= secs) close += 86400;
+        return system_clock::time_point(seconds(close));
+    }
+
+    // GTT orders expire at their own expireAt and DAY orders at the next
+    // session close; everything else that rests expires the instrument's
+    // orderExpirySeconds after placement.  The tick is rounded up so an
+    // order never expires before its time.
+    void scheduleExpiry(const Order& order) {
+        const OrderDetails& details = pool_.details(order.getPoolHandle());
+        std::chrono::system_clock::time_point expireAt;
+        switch (order.getTimeInForce()) {
+            case TimeInForce::GTT: expireAt = details.getExpireAt(); break;
+            case TimeInForce::DAY: expireAt = sessionCloseAfter(details.getSubmitTimestamp()); break;
+            default:
+                expireAt = details.getSubmitTimestamp()
+                         + std::chrono::seconds(getInstrument().orderExpirySeconds);
+        }
+        const auto endOfTick = expireAt + std::chrono::milliseconds(TIMER_WHEEL_TICK_MS - 1);
+        expiryWheel_.schedule(order.getOrderId(), TimerService::toTick(endOfTick));
+    }
+
+    // Caller holds mutex_.  Fire the wheel up to the last posted tick; only
+    // due entries are visited, and entries for orders that were filled or
+    // cancelled meanwhile are simply dropped.
+    void runPostedTimers() {
+        const uint64_t now = postedTick_.load(std::memory_order_acquire);
+        if (now < expiryWheel_.current()) return;
+        expiryWheel_.advance(now, [this](OrderId orderId) {
+            const OrderHandle handle = orderIndex_.find(orderId);
+            if (handle == INVALID_ORDER_HANDLE) {         // a parked stop, or gone
+                removeStop(orderId, /*expired=*/true);
+                return;
             }
+            // Remove from its price level and orderIndex_, log EXPIRED, recycle the slot.
+            Order* order = &pool_[handle];
+            emitOrder(MarketDataEvent::ORDER_DELETE, *order, order->getRemainingQuantity());
+            removeOrderFromBook(*order);
+            depthChanged_ = true;
+            order->expire();
+            publishOrder(*order);
+            pool_.release(order);
+        });
+    }
+
+    // Caller holds mutex_; closes every critical section that may have
+    // changed the book.
+    void endBatch() {
+        publishDepth();
+        if (logger_ && logRows_.tellp() > 0) {
+            logger_->send(logRows_.str());
+            logRows_.str(std::string());
         }
     }
 
-    std::map<double, std::shared_ptr<PriceLevel>> buyLevels_;
-    std::map<double, std::shared_ptr<PriceLevel>> sellLevels_;
-    std::unordered_map<std::string, std::shared_ptr<Order>> orderMap_;
+    // Caller holds mutex_.  Republish market data if anything changed since
+    // the last publication — once per LOCKED call or consumer batch, not per
+    // order.  The batch's feed events go out first, so a snapshot never
+    // claims a feedSequence the journal does not have yet.
+    void publishDepth() {
+        if (!depthChanged_) return;
+        depthChanged_ = false;
+
+        for (auto* stream : {&pendingEvents_, &pendingOrderEvents_}) {
+            if (stream->empty()) continue;
+            (stream == &pendingEvents_ ? feed_ : orderFeed_).append(*stream);
+            if (marketDataListener_)
+                for (const MarketDataEvent& event : *stream) marketDataListener_(event);
+            stream->clear();
+        }
+
+        BookSnapshot snapshot;
+        snapshot.version      = ++depthVersion_;
+        snapshot.feedSequence = feedSequence_;
+        snapshot.bidCount = buyDepth_.size();
+        snapshot.askCount = sellDepth_.size();
+        snapshot.bids     = buyDepth_.levels();
+        snapshot.asks     = sellDepth_.levels();
+
+        TopOfBook top;
+        if (snapshot.bidCount) { top.bidPrice = snapshot.bids[0].price; top.bidQuantity = snapshot.bids[0].quantity; }
+        if (snapshot.askCount) { top.askPrice = snapshot.asks[0].price; top.askQuantity = snapshot.asks[0].quantity; }
+        topOfBook_.store(top);
+        depth_.store(snapshot);
+    }
+
+    int instrumentId_;
+    BookType bookType_;
+    ExecutionMode executionMode_;
+    std::unique_ptr<BookSide> buyLevels_;
+    std::unique_ptr<BookSide> sellLevels_;
+    DepthCache buyDepth_{OrderSide::BUY};               // top levels, maintained in place
+    DepthCache sellDepth_{OrderSide::SELL};
+    OrderPool pool_;                                    // owns every live Order
+    OrderIndex orderIndex_;                             // resting orders only
+    TraderOrderIndex traderOrders_;                     // resting orders and parked stops by trader
+    StopBook stopBook_;                                 // parked stops by trigger price
+    OrderIndex stopIndex_;                              // parked stops by id
+    std::vector<OrderHandle> triggeredStops_;           // fireStops() scratch
+    Price lastTradePrice_ = 0;                          // ticks; 0 until the first trade;
+                                                        // stop trigger and LADDER centre
+    Price tradeLow_  = 0;                               // prints since fireStops() last ran
+    Price tradeHigh_ = 0;                               // (0 = none)
+    std::map<TraderIndex, QuoteSlots> quotes_;          // mass-quote slots, guarded by mutex_
     mutable std::mutex mutex_;
     std::vector<Trade> recentTrades_;
     Logger* logger_;
+    OrderListener orderListener_;
+    std::ostringstream logRows_;                        // unsent log rows, guarded by mutex_
+    MarketDataListener marketDataListener_;
+    std::atomic<uint64_t> nextOrderSequence_;
+    uint64_t nextTradeSequence_;                        // guarded by mutex_
 
     std::atomic<size_t> totalVolume_;
     std::atomic<size_t> buyVolume_;
     std::atomic<size_t> sellVolume_;
     std::atomic<size_t> tradeCount_;
 
-    // Expiry thread members
-    std::atomic<bool>   expiryRunning_;
-    std::thread         expiryThread_;
+    // Published market data (written under mutex_, read lock-free)
+    Seqlock<TopOfBook>           topOfBook_;
+    Seqlock<BookSnapshot>        depth_;
+    bool                         depthChanged_ = false; // guarded by mutex_
+    uint64_t                     depthVersion_ = 0;     // guarded by mutex_
+    MarketDataJournal            feed_;                 // internally locked
+    std::vector<MarketDataEvent> pendingEvents_;        // this batch, guarded by mutex_
+    uint64_t                     feedSequence_ = 0;     // guarded by mutex_
+    MarketDataJournal            orderFeed_;            // L3, internally locked
+    std::vector<MarketDataEvent> pendingOrderEvents_;   // this batch, guarded by mutex_
+    uint64_t                     orderFeedSequence_ = 0; // guarded by mutex_
+
+    // Expiry wheel; ticks are posted by the TimerService thread
+    TimerWheel            expiryWheel_;                 // guarded by mutex_
+    std::atomic<uint64_t> postedTick_;                  // latest tick posted
+
+    // DEDICATED / POOLED only (commands_ is null for LOCKED books)
+    std::unique_ptr<MpscRing<Command, BOOK_COMMAND_RING_SIZE>> commands_;
+    Command                 polled_;                    // consumer's pop target
+    std::vector<Completion> completions_;               // this batch, consumer only
+    std::vector<Completion> completing_;                // being completed, outside mutex_
+    std::atomic<uint64_t>   commandsExecuted_{0};       // load metric for MatchingPool
+    std::thread             matchingThread_;            // DEDICATED
+    std::atomic<bool>       matchingRunning_{false};
+    std::atomic<bool>       matchingParked_{false};
+    std::mutex              parkMutex_;
+    std::condition_variable parkCv_;
+
+    // POOLED only: set by MatchingPool
+    friend class MatchingPool;
+    BookScheduler*          scheduler_ = nullptr;
+    std::atomic<unsigned>   ownerWorker_{0};
 };
 
 #endif // ORDER_BOOK_HPP
@@ -0,0 +1,106 @@
+#ifndef ORDER_INDEX_HPP
+#define ORDER_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+#include "Order.hpp"
+
+// Initial slot count (power of two).  The table doubles past 50 % load.
+static constexpr size_t ORDER_INDEX_INITIAL_CAPACITY = 1024;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OrderIndex — OrderId → OrderPool slot, open addressing with linear probing.
+//
+//  One flat array of 16-byte {id, handle} entries: a lookup hashes the 64-bit
+//  ID, lands on one cache line and usually finds the entry there, then the
+//  handle resolves the Order in the pool — two cache misses in the common
+//  case and no per-entry allocation.  Deletion uses backward-shift (no
+//  tombstones), so probe sequences stay short under heavy cancel/fill churn.
+//
+//  ID 0 marks an empty entry; real IDs always carry a non-zero instrument in
+//  their top bits.  Not thread-safe: owned and guarded by the OrderBook.
+// ─────────────────────────────────────────────────────────────────────────────
+class OrderIndex {
+public:
+    OrderIndex() : entries_(ORDER_INDEX_INITIAL_CAPACITY), mask_(ORDER_INDEX_INITIAL_CAPACITY - 1) {}
+
+    // Insert or overwrite.
+    void insert(OrderId id, OrderHandle handle) {
+        if ((size_ + 1) * 2 > entries_.size()) grow();
+        size_t i = home(id);
+        while (entries_[i].id != EMPTY && entries_[i].id != id) i = (i + 1) & mask_;
+        if (entries_[i].id == EMPTY) ++size_;
+        entries_[i] = Entry{id, handle};
+    }
+
+    // Handle for `id`, or INVALID_ORDER_HANDLE.
+    OrderHandle find(OrderId id) const {
+        for (size_t i = home(id);; i = (i + 1) & mask_) {
+            if (entries_[i].id == id)    return entries_[i].handle;
+            if (entries_[i].id == EMPTY) return INVALID_ORDER_HANDLE;
+        }
+    }
+
+    // Returns false if `id` was not present.
+    bool erase(OrderId id) {
+        size_t i = home(id);
+        for (;; i = (i + 1) & mask_) {
+            if (entries_[i].id == id)    break;
+            if (entries_[i].id == EMPTY) return false;
+        }
+        // Backward-shift: pull later entries of the cluster into the hole
+        // whenever the hole lies on their probe path.
+        for (size_t j = (i + 1) & mask_; entries_[j].id != EMPTY; j = (j + 1) & mask_) {
+            size_t h = home(entries_[j].id);
+            if (((j - h) & mask_) >= ((j - i) & mask_)) {
+                entries_[i] = entries_[j];
+                i = j;
+            }
+        }
+        entries_[i].id = EMPTY;
+        --size_;
+        return true;
+    }
+
+    size_t size()  const { return size_; }
+    bool   empty() const { return size_ == 0; }
+
+    // Visit every (id, handle); `fn` must not modify the index.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Entry& e : entries_)
+            if (e.id != EMPTY) fn(e.id, e.handle);
+    }
+
+private:
+    static constexpr OrderId EMPTY = 0;
+
+    struct Entry {
+        OrderId     id     = EMPTY;
+        OrderHandle handle = INVALID_ORDER_HANDLE;
+    };
+
+    // Sequential IDs differ only in their low bits; mix so clusters spread.
+    size_t home(OrderId id) const {
+        uint64_t x = id;
+        x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x) & mask_;
+    }
+
+    void grow() {
+        std::vector<Entry> old(entries_.size() * 2);
+        old.swap(entries_);
+        mask_ = entries_.size() - 1;
+        size_ = 0;
+        for (const Entry& e : old)
+            if (e.id != EMPTY) insert(e.id, e.handle);
+    }
+
+    std::vector<Entry> entries_;
+    size_t             mask_;
+    size_t             size_ = 0;
+};
+
+#endif // ORDER_INDEX_HPP
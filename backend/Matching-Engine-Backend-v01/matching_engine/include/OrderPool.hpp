@@ -0,0 +1,110 @@
+#ifndef ORDER_POOL_HPP
+#define ORDER_POOL_HPP
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include "Order.hpp"
+
+// Orders per slab.  Must be a power of two (slot lookup is shift + mask).
+static constexpr size_t ORDER_POOL_SLAB_SIZE = 1024;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  OrderPool — per-book slab allocator for Order objects.
+//
+//  Orders are constructed in place inside fixed-size slabs that are never
+//  moved or freed while the pool lives, so an Order* (and its OrderHandle,
+//  the dense slot index) stays valid until release().  Each slot has two
+//  halves in parallel slabs: the 64-byte hot Order the matching loop walks,
+//  and its cold OrderDetails, so the hot slabs are densely packed lines.  Released slots go on a
+//  LIFO free list and are reused first, which keeps the hot working set small
+//  and cache-resident.  Once the pool has grown to the book's peak number of
+//  live orders, acquire/release perform no heap allocation.
+//
+//  Not thread-safe: the owning OrderBook calls it under its own mutex.
+// ─────────────────────────────────────────────────────────────────────────────
+class OrderPool {
+public:
+    OrderPool() = default;
+
+    ~OrderPool() {
+        for (OrderHandle h = 0; h < live_.size(); ++h)
+            if (live_[h]) destroy(h);
+    }
+
+    OrderPool(const OrderPool&)            = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    Order* acquire(OrderId orderId, const OrderRequest& request) {
+        if (freeList_.empty()) grow();
+        OrderHandle h = freeList_.back();
+        freeList_.pop_back();
+        Order* order = new (slot(h)) Order(orderId, request);
+        new (detailSlot(h)) OrderDetails(request);
+        order->poolHandle_ = h;
+        live_[h] = 1;
+        ++liveCount_;
+        return order;
+    }
+
+    void release(Order* order) {
+        OrderHandle h = order->poolHandle_;
+        destroy(h);
+        live_[h] = 0;
+        --liveCount_;
+        freeList_.push_back(h);
+    }
+
+    Order&       operator[](OrderHandle h)       { return *slot(h); }
+    const Order& operator[](OrderHandle h) const { return *slot(h); }
+
+    OrderDetails&       details(OrderHandle h)       { return *detailSlot(h); }
+    const OrderDetails& details(OrderHandle h) const { return *detailSlot(h); }
+
+    bool   isLive(OrderHandle h) const { return h < live_.size() && live_[h]; }
+    size_t liveCount()           const { return liveCount_; }
+    size_t capacity()            const { return slabs_.size() * ORDER_POOL_SLAB_SIZE; }
+
+private:
+    using Storage       = std::aligned_storage_t<sizeof(Order), alignof(Order)>;
+    using DetailStorage = std::aligned_storage_t<sizeof(OrderDetails), alignof(OrderDetails)>;
+
+    static_assert((ORDER_POOL_SLAB_SIZE & (ORDER_POOL_SLAB_SIZE - 1)) == 0,
+                  "ORDER_POOL_SLAB_SIZE must be a power of two");
+
+    Order* slot(OrderHandle h) const {
+        return reinterpret_cast<Order*>(
+            &slabs_[h / ORDER_POOL_SLAB_SIZE][h & (ORDER_POOL_SLAB_SIZE - 1)]);
+    }
+
+    OrderDetails* detailSlot(OrderHandle h) const {
+        return reinterpret_cast<OrderDetails*>(
+            &detailSlabs_[h / ORDER_POOL_SLAB_SIZE][h & (ORDER_POOL_SLAB_SIZE - 1)]);
+    }
+
+    void destroy(OrderHandle h) {
+        slot(h)->~Order();
+        detailSlot(h)->~OrderDetails();
+    }
+
+    void grow() {
+        const OrderHandle first = static_cast<OrderHandle>(capacity());
+        slabs_.emplace_back(new Storage[ORDER_POOL_SLAB_SIZE]);
+        detailSlabs_.emplace_back(new DetailStorage[ORDER_POOL_SLAB_SIZE]);
+        live_.resize(capacity(), 0);
+        freeList_.reserve(capacity());
+        // Push in reverse so the lowest new slot is handed out first.
+        for (size_t i = ORDER_POOL_SLAB_SIZE; i-- > 0;)
+            freeList_.push_back(first + static_cast<OrderHandle>(i));
+    }
+
+    std::vector<std::unique_ptr<Storage[]>>       slabs_;        // hot Orders
+    std::vector<std::unique_ptr<DetailStorage[]>> detailSlabs_;  // cold OrderDetails
+    std::vector<OrderHandle>                      freeList_;
+    std::vector<uint8_t>                          live_;
+    size_t                                        liveCount_ = 0;
+};
+
+#endif // ORDER_POOL_HPP
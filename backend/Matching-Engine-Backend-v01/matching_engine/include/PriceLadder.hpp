@@ -0,0 +1,193 @@
+#ifndef PRICE_LADDER_HPP
+#define PRICE_LADDER_HPP
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "BookSide.hpp"
+#include "OccupancyBitmap.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  LadderBookSide — contiguous array of levels indexed by tick offset.
+//
+//    slot = price - base_          (base_ = centre - window / 2)
+//
+//  Level objects are allocated the first time a slot is used and are kept
+//  when the level empties, so steady-state inserts and removals touch the
+//  array only — no tree walk and no node allocation.  Occupied slots are
+//  tracked in an OccupancyBitmap; the best level index is cached, and when
+//  the best level empties the next one is found with a few ctz/clz steps
+//  rather than a scan over empty ticks.
+//
+//  Prices outside the window go to a small ordered overflow map.  When the
+//  reference price passed to track() drifts more than a quarter window from
+//  the centre, the ladder re-centres: levels are moved (not copied) between
+//  the array and the overflow map, so PriceLevel addresses stay stable.
+// ─────────────────────────────────────────────────────────────────────────────
+class LadderBookSide : public BookSide {
+public:
+    // `windowTicks` is rounded up to a power of two.
+    LadderBookSide(OrderSide side, Price centre, size_t windowTicks)
+        : BookSide(side)
+        , occupied_(roundUpPow2(windowTicks))
+    {
+        const size_t window = roundUpPow2(windowTicks);
+        levels_.resize(window);
+        base_ = centre - static_cast<Price>(window / 2);
+    }
+
+    PriceLevel* find(Price price) override {
+        if (inWindow(price)) {
+            size_t idx = slot(price);
+            return occupied_.test(idx) ? levels_[idx].get() : nullptr;
+        }
+        auto it = overflow_.find(price);
+        return it == overflow_.end() ? nullptr : it->second.get();
+    }
+
+    PriceLevel& findOrCreate(Price price) override {
+        if (!inWindow(price)) {
+            auto& level = overflow_[price];
+            if (!level) level = std::make_unique<PriceLevel>(price);
+            return *level;
+        }
+        size_t idx = slot(price);
+        auto& level = levels_[idx];
+        if (!level) level = std::make_unique<PriceLevel>(price);
+        if (!occupied_.test(idx)) {
+            occupied_.set(idx);
+            ++ladderCount_;
+            if (bestIdx_ < 0 || isBetterSlot(idx, static_cast<size_t>(bestIdx_)))
+                bestIdx_ = static_cast<long>(idx);
+        }
+        return *level;
+    }
+
+    void removeLevel(Price price) override {
+        if (!inWindow(price)) {
+            overflow_.erase(price);
+            return;
+        }
+        size_t idx = slot(price);
+        if (!occupied_.test(idx)) return;
+        occupied_.clear(idx);
+        --ladderCount_;
+        if (static_cast<long>(idx) == bestIdx_)
+            bestIdx_ = side_ == OrderSide::BUY ? occupied_.nextBelow(idx) : occupied_.nextAbove(idx);
+    }
+
+    PriceLevel* best() override {
+        if (!overflow_.empty()) {
+            // Overflow prices beyond the better edge of the window win outright.
+            if (side_ == OrderSide::BUY && overflow_.rbegin()->first >= top())
+                return overflow_.rbegin()->second.get();
+            if (side_ == OrderSide::SELL && overflow_.begin()->first < base_)
+                return overflow_.begin()->second.get();
+        }
+        if (bestIdx_ >= 0) return levels_[bestIdx_].get();
+        if (overflow_.empty()) return nullptr;
+        return side_ == OrderSide::BUY ? overflow_.rbegin()->second.get()
+                                       : overflow_.begin()->second.get();
+    }
+
+    bool   empty()      const override { return ladderCount_ == 0 && overflow_.empty(); }
+    size_t levelCount() const override { return ladderCount_ + overflow_.size(); }
+
+    void forEachLevel(const std::function<bool(const PriceLevel&)>& fn) const override {
+        if (side_ == OrderSide::BUY) {
+            // above window (desc) → ladder (desc) → below window (desc)
+            auto it = overflow_.rbegin();
+            for (; it != overflow_.rend() && it->first >= top(); ++it)
+                if (!fn(*it->second)) return;
+            for (long i = bestIdx_; i >= 0; i = occupied_.nextBelow(static_cast<size_t>(i)))
+                if (!fn(*levels_[i])) return;
+            for (; it != overflow_.rend(); ++it)
+                if (!fn(*it->second)) return;
+        } else {
+            // below window (asc) → ladder (asc) → above window (asc)
+            auto it = overflow_.begin();
+            for (; it != overflow_.end() && it->first < base_; ++it)
+                if (!fn(*it->second)) return;
+            for (long i = bestIdx_; i >= 0; i = occupied_.nextAbove(static_cast<size_t>(i)))
+                if (!fn(*levels_[i])) return;
+            for (; it != overflow_.end(); ++it)
+                if (!fn(*it->second)) return;
+        }
+    }
+
+    void track(Price reference) override {
+        Price centre = base_ + static_cast<Price>(levels_.size() / 2);
+        Price drift  = reference > centre ? reference - centre : centre - reference;
+        if (drift > static_cast<Price>(levels_.size() / 4)) recentre(reference);
+    }
+
+    Price  getBase()   const { return base_; }
+    size_t getWindow() const { return levels_.size(); }
+
+private:
+    Price top() const { return base_ + static_cast<Price>(levels_.size()); }
+    bool  inWindow(Price price) const { return price >= base_ && price < top(); }
+    size_t slot(Price price) const { return static_cast<size_t>(price - base_); }
+
+    bool isBetterSlot(size_t a, size_t b) const {
+        return side_ == OrderSide::BUY ? a > b : a < b;
+    }
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Move the window so it is centred on `centre`.  O(window + overflow);
+    // only runs when the market has drifted a quarter window away.
+    void recentre(Price centre) {
+        const size_t window  = levels_.size();
+        const Price  newBase = centre - static_cast<Price>(window / 2);
+        if (newBase == base_) return;
+
+        std::vector<std::unique_ptr<PriceLevel>> moved(window);
+        std::vector<uint8_t>                     occ(window, 0);   // staging: old bitmap is still read below
+        auto place = [&](Price price, std::unique_ptr<PriceLevel> level, bool live) {
+            if (price >= newBase && price < newBase + static_cast<Price>(window)) {
+                size_t idx = static_cast<size_t>(price - newBase);
+                moved[idx] = std::move(level);
+                occ[idx]   = live ? 1 : 0;
+            } else if (live) {
+                overflow_[price] = std::move(level);
+            }
+        };
+
+        for (size_t i = 0; i < window; ++i)
+            if (levels_[i]) place(base_ + static_cast<Price>(i), std::move(levels_[i]), occupied_.test(i));
+        for (auto it = overflow_.begin(); it != overflow_.end();) {
+            if (it->first >= newBase && it->first < newBase + static_cast<Price>(window)) {
+                place(it->first, std::move(it->second), true);
+                it = overflow_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        levels_.swap(moved);
+        occupied_.reset();
+        base_        = newBase;
+        ladderCount_ = 0;
+        for (size_t i = 0; i < window; ++i) {
+            if (!occ[i]) continue;
+            occupied_.set(i);
+            ++ladderCount_;
+        }
+        bestIdx_ = side_ == OrderSide::BUY ? occupied_.highest() : occupied_.lowest();
+    }
+
+    std::vector<std::unique_ptr<PriceLevel>>    levels_;
+    OccupancyBitmap                             occupied_;
+    Price                                       base_        = 0;
+    long                                        bestIdx_     = -1;
+    size_t                                      ladderCount_ = 0;
+    std::map<Price, std::unique_ptr<PriceLevel>> overflow_;
+};
+
+#endif // PRICE_LADDER_HPP
@@ -1,62 +1,89 @@
 #ifndef PRICE_LEVEL_HPP
 #define PRICE_LEVEL_HPP
 
-#include <deque>
-#include <memory>
-#include <mutex>
-#include <algorithm>
 #include "Order.hpp"
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  PriceLevel — FIFO queue of resting orders at one price.
+//
+//  The queue is intrusive: each Order carries its own prev/next links and a
+//  back-pointer to the level it rests on, so removing an order from anywhere
+//  in the queue (cancel, expiry, fill) is O(1) with no search and no
+//  allocation.  All mutation happens under the owning OrderBook's mutex;
+//  readers see levels only through the book's published snapshots.
+//  totalQuantity_ is the sum of the queued orders' remaining quantities, so
+//  the book reports every partial fill of a queued order via reduceQuantity().
+// ─────────────────────────────────────────────────────────────────────────────
 class PriceLevel {
 public:
-    explicit PriceLevel(double price) : price_(price), totalQuantity_(0) {}
+    explicit PriceLevel(Price price) : price_(price), totalQuantity_(0) {}
 
-    void addOrder(std::shared_ptr<Order> order) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        orders_.push_back(order);
+    PriceLevel(const PriceLevel&)            = delete;
+    PriceLevel& operator=(const PriceLevel&) = delete;
+
+    // Append to the back of the queue (time priority).
+    void addOrder(Order* order) {
+        order->level_       = this;
+        order->prevInLevel_ = tail_;
+        order->nextInLevel_ = nullptr;
+        if (tail_) tail_->nextInLevel_ = order;
+        else       head_ = order;
+        tail_ = order;
+        ++orderCount_;
         totalQuantity_ += order->getRemainingQuantity();
     }
 
-    std::shared_ptr<Order> getFirstOrder() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return orders_.empty() ? nullptr : orders_.front();
+    Order* getFirstOrder() const { return head_; }
+
+    // Visit the queue front to back (time priority).
+    template <typename Fn>
+    void forEachOrder(Fn&& fn) const {
+        for (const Order* order = head_; order; order = order->nextInLevel_) fn(*order);
+    }
+
+    // A queued order was partly or fully filled by `quantity`.
+    void reduceQuantity(size_t quantity) {
+        totalQuantity_ -= quantity;
     }
 
-    void removeOrder(const std::string& orderId) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = std::find_if(orders_.begin(), orders_.end(),
-            [&orderId](const std::shared_ptr<Order>& order) {
-                return order->getOrderId() == orderId;
-            });
-        
-        if (it != orders_.end()) {
-            totalQuantity_ -= (*it)->getRemainingQuantity();
-            orders_.erase(it);
-        }
+    // Unlink `order`, which must currently rest on this level.
+    void removeOrder(Order* order) {
+        if (order->level_ != this) return;
+        if (order->prevInLevel_) order->prevInLevel_->nextInLevel_ = order->nextInLevel_;
+        else                     head_ = order->nextInLevel_;
+        if (order->nextInLevel_) order->nextInLevel_->prevInLevel_ = order->prevInLevel_;
+        else                     tail_ = order->prevInLevel_;
+        order->level_       = nullptr;
+        order->prevInLevel_ = nullptr;
+        order->nextInLevel_ = nullptr;
+        --orderCount_;
+        totalQuantity_ -= order->getRemainingQuantity();
+        // Ladder books reuse emptied levels, so never carry a stale total.
+        if (!head_) totalQuantity_ = 0;
     }
 
     bool isEmpty() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return orders_.empty();
+        return head_ == nullptr;
+    }
+
+    size_t getOrderCount() const {
+        return orderCount_;
     }
 
     size_t getTotalQuantity() const {
         return totalQuantity_;
     }
 
-    double getPrice() const {
+    Price getPrice() const {
         return price_;
     }
 
-    const std::deque<std::shared_ptr<Order>>& getOrders() const {
-        return orders_;
-    }
-
 private:
-    double price_;
-    std::atomic<size_t> totalQuantity_;
-    std::deque<std::shared_ptr<Order>> orders_;
-    mutable std::mutex mutex_;
+    Price price_;   // in ticks
+    size_t totalQuantity_;
+    size_t orderCount_ = 0;
+    Order* head_ = nullptr;
+    Order* tail_ = nullptr;
 };
 
-#endif // PRICE_LEVEL_HPP
\ No newline at end of file
+#endif // PRICE_LEVEL_HPP
@@ -0,0 +1,76 @@
+#ifndef STOP_BOOK_HPP
+#define STOP_BOOK_HPP
+
+#include <map>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include "Order.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  StopBook — one book's parked STOP / STOP_LIMIT orders, by trigger price.
+//
+//  A BUY stop triggers once the last trade price rises to its stop price, a
+//  SELL stop once it falls to it.  Each side maps stop price → the parked
+//  orders' pool handles in arrival order, sorted so the stops nearest to
+//  triggering come first.  takeTriggered() only ever pops from the front
+//  while the front price is crossed: prints that trigger nothing cost one
+//  look at each side, and ones that trigger k stops visit just those k.
+//
+//  Not thread-safe: owned and guarded by the OrderBook.
+// ─────────────────────────────────────────────────────────────────────────────
+class StopBook {
+public:
+    void add(OrderSide side, Price stopPrice, OrderHandle handle) {
+        if (side == OrderSide::BUY) buyStops_[stopPrice].push_back(handle);
+        else                        sellStops_[stopPrice].push_back(handle);
+        ++count_;
+    }
+
+    // Returns false if the order is not parked here.
+    bool remove(OrderSide side, Price stopPrice, OrderHandle handle) {
+        return side == OrderSide::BUY ? removeFrom(buyStops_, stopPrice, handle)
+                                      : removeFrom(sellStops_, stopPrice, handle);
+    }
+
+    // Move every stop reached by trades printed between `low` and `high`
+    // into `out`: buys at or below `high`, then sells at or above `low`,
+    // each in trigger-price then arrival order.
+    void takeTriggered(Price low, Price high, std::vector<OrderHandle>& out) {
+        while (!buyStops_.empty() && buyStops_.begin()->first <= high)
+            take(buyStops_, out);
+        while (!sellStops_.empty() && sellStops_.begin()->first >= low)
+            take(sellStops_, out);
+    }
+
+    size_t size()  const { return count_; }
+    bool   empty() const { return count_ == 0; }
+
+private:
+    template <typename Map>
+    bool removeFrom(Map& stops, Price stopPrice, OrderHandle handle) {
+        auto it = stops.find(stopPrice);
+        if (it == stops.end()) return false;
+        auto pos = std::find(it->second.begin(), it->second.end(), handle);
+        if (pos == it->second.end()) return false;
+        it->second.erase(pos);
+        if (it->second.empty()) stops.erase(it);
+        --count_;
+        return true;
+    }
+
+    template <typename Map>
+    void take(Map& stops, std::vector<OrderHandle>& out) {
+        auto it = stops.begin();
+        out.insert(out.end(), it->second.begin(), it->second.end());
+        count_ -= it->second.size();
+        stops.erase(it);
+    }
+
+    std::map<Price, std::vector<OrderHandle>>                      buyStops_;   // lowest stop first
+    std::map<Price, std::vector<OrderHandle>, std::greater<Price>> sellStops_;  // highest stop first
+    size_t count_ = 0;
+};
+
+#endif // STOP_BOOK_HPP
@@ -0,0 +1,151 @@
+#ifndef THREAD_TUNING_HPP
+#define THREAD_TUNING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Engine thread groups that can be given their own CPUs.
+enum class ThreadRole {
+    MATCHING,   // DEDICATED book threads and MatchingPool workers
+    TIMER,      // TimerService
+    HTTP,       // book server (port 9100)
+    TRADERS,    // mock traders and the circular-ring coordinator
+    COUNT
+};
+
+// How an idle matching thread waits for work.
+enum class WaitStrategy {
+    BUSY_SPIN,       // never sleeps: lowest wake-up latency, burns its core
+    SPIN_THEN_PARK,  // spins for a bounded number of idle polls, then parks
+    BLOCKING         // parks (futex via condition_variable) as soon as idle
+};
+
+static constexpr WaitStrategy DEFAULT_WAIT_STRATEGY   = WaitStrategy::SPIN_THEN_PARK;
+static constexpr unsigned     DEFAULT_SPIN_ITERATIONS = 2000;
+
+// Spin-loop hint: keeps a busy-polling core from starving its hyper-thread
+// sibling and from flooding the memory pipeline.
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ThreadTuning — CPU placement and wait strategy for engine threads.
+//
+//  Read once from the environment:
+//    ME_CPUS_MATCHING   e.g. "2-5"  each matching thread is pinned to ONE of
+//                                   these CPUs, handed out round-robin
+//    ME_CPUS_TIMER      e.g. "1"    threads of the other roles may float
+//    ME_CPUS_HTTP       e.g. "1"    across their whole set
+//    ME_CPUS_TRADERS    e.g. "6-15"
+//    ME_WAIT_STRATEGY   spin | spin_park | block   (matching threads)
+//    ME_SPIN_ITERATIONS idle polls before parking under spin_park
+//
+//  An unset or empty list leaves that role unpinned.  Pinning is Linux-only;
+//  elsewhere pin() is a no-op.  To reserve isolated cores for matching, list
+//  them in ME_CPUS_MATCHING (and isolcpus=) and keep them out of every other set.
+// ─────────────────────────────────────────────────────────────────────────────
+class ThreadTuning {
+public:
+    static ThreadTuning& getInstance() {
+        static ThreadTuning instance;
+        return instance;
+    }
+
+    // Apply the role's CPU placement to the calling thread.
+    void pin(ThreadRole role) {
+        const std::vector<int>& cpus = cpus_[static_cast<size_t>(role)];
+        if (cpus.empty()) return;
+        if (role == ThreadRole::MATCHING)
+            setAffinity({cpus[nextMatchingCpu_.fetch_add(1) % cpus.size()]});
+        else
+            setAffinity(cpus);
+    }
+
+    WaitStrategy waitStrategy()   const { return waitStrategy_; }
+    unsigned     spinIterations() const { return spinIterations_; }
+
+    // For an idle loop: true while the thread should keep polling rather
+    // than park, given how many consecutive idle polls it has made.
+    bool keepSpinning(unsigned idlePolls) const {
+        return waitStrategy_ == WaitStrategy::BUSY_SPIN ||
+               (waitStrategy_ == WaitStrategy::SPIN_THEN_PARK && idlePolls < spinIterations_);
+    }
+
+    // "0,2,4-7" → {0,2,4,5,6,7}.  Malformed entries are skipped.
+    static std::vector<int> parseCpuList(const char* text) {
+        std::vector<int> cpus;
+        if (!text) return cpus;
+        const std::string s(text);
+        size_t pos = 0;
+        while (pos < s.size()) {
+            size_t end = s.find(',', pos);
+            if (end == std::string::npos) end = s.size();
+            const std::string item = s.substr(pos, end - pos);
+            const size_t dash = item.find('-');
+            char* rest = nullptr;
+            const long lo = std::strtol(item.c_str(), &rest, 10);
+            const long hi = dash == std::string::npos ? lo
+                                                      : std::strtol(item.c_str() + dash + 1, nullptr, 10);
+            if (rest != item.c_str() && lo >= 0 && hi >= lo)
+                for (long c = lo; c <= hi; ++c) cpus.push_back(static_cast<int>(c));
+            pos = end + 1;
+        }
+        return cpus;
+    }
+
+private:
+    ThreadTuning() {
+        cpus_[static_cast<size_t>(ThreadRole::MATCHING)] = parseCpuList(std::getenv("ME_CPUS_MATCHING"));
+        cpus_[static_cast<size_t>(ThreadRole::TIMER)]    = parseCpuList(std::getenv("ME_CPUS_TIMER"));
+        cpus_[static_cast<size_t>(ThreadRole::HTTP)]     = parseCpuList(std::getenv("ME_CPUS_HTTP"));
+        cpus_[static_cast<size_t>(ThreadRole::TRADERS)]  = parseCpuList(std::getenv("ME_CPUS_TRADERS"));
+
+        const char* strategy = std::getenv("ME_WAIT_STRATEGY");
+        if (strategy && std::string(strategy) == "spin")      waitStrategy_ = WaitStrategy::BUSY_SPIN;
+        if (strategy && std::string(strategy) == "spin_park") waitStrategy_ = WaitStrategy::SPIN_THEN_PARK;
+        if (strategy && std::string(strategy) == "block")     waitStrategy_ = WaitStrategy::BLOCKING;
+
+        const char* spins = std::getenv("ME_SPIN_ITERATIONS");
+        if (spins && std::atoi(spins) > 0) spinIterations_ = static_cast<unsigned>(std::atoi(spins));
+    }
+
+    ThreadTuning(const ThreadTuning&)            = delete;
+    ThreadTuning& operator=(const ThreadTuning&) = delete;
+
+    static void setAffinity(const std::vector<int>& cpus) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            std::fprintf(stderr, "[ThreadTuning] Could not pin thread (CPU %d%s)\n",
+                         cpus.front(), cpus.size() > 1 ? ", ..." : "");
+#else
+        (void)cpus;
+#endif
+    }
+
+    std::array<std::vector<int>, static_cast<size_t>(ThreadRole::COUNT)> cpus_;
+    std::atomic<unsigned> nextMatchingCpu_{0};
+    WaitStrategy          waitStrategy_   = DEFAULT_WAIT_STRATEGY;
+    unsigned              spinIterations_ = DEFAULT_SPIN_ITERATIONS;
+};
+
+#endif // THREAD_TUNING_HPP
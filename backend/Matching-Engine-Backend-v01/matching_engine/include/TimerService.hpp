@@ -0,0 +1,91 @@
+#ifndef TIMER_SERVICE_HPP
+#define TIMER_SERVICE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "ThreadTuning.hpp"
+
+// Engine-wide timer resolution: TimerService ticks, and every book's expiry
+// TimerWheel counts, in periods of this many milliseconds.
+static constexpr int TIMER_WHEEL_TICK_MS = 100;
+
+// Receiver of TimerService ticks.  onTimerTick() runs on the service thread
+// and must only post work to the client's own execution context — it must
+// not block (e.g. on a book mutex another thread holds).
+class TimerClient {
+public:
+    virtual ~TimerClient() = default;
+    virtual void onTimerTick(uint64_t nowTick) = 0;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TimerService — the single engine-wide clock thread.
+//
+//  Replaces one sleeping expiry thread per OrderBook: books subscribe on
+//  construction, and once per TIMER_WHEEL_TICK_MS the service hands every
+//  subscriber the current tick.  Expiry, DAY-order session close and any
+//  other time-based book events are driven from the book side of that call,
+//  so adding instruments adds no threads.
+//
+//  subscribe()/unsubscribe() synchronise with the tick loop: once
+//  unsubscribe() returns, the service will not call the client again.
+// ─────────────────────────────────────────────────────────────────────────────
+class TimerService {
+public:
+    static TimerService& getInstance() {
+        static TimerService instance;
+        return instance;
+    }
+
+    // Whole TIMER_WHEEL_TICK_MS periods since the epoch.
+    static uint64_t toTick(std::chrono::system_clock::time_point tp) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            tp.time_since_epoch()).count();
+        return ms <= 0 ? 0 : static_cast<uint64_t>(ms) / TIMER_WHEEL_TICK_MS;
+    }
+
+    static uint64_t nowTick() { return toTick(std::chrono::system_clock::now()); }
+
+    void subscribe(TimerClient* client) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clients_.push_back(client);
+    }
+
+    void unsubscribe(TimerClient* client) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+    }
+
+private:
+    TimerService() : running_(true) {
+        thread_ = std::thread([this]() {
+            ThreadTuning::getInstance().pin(ThreadRole::TIMER);
+            while (running_.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(TIMER_WHEEL_TICK_MS));
+                const uint64_t tick = nowTick();
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (TimerClient* client : clients_) client->onTimerTick(tick);
+            }
+        });
+    }
+
+    ~TimerService() {
+        running_.store(false);
+        if (thread_.joinable()) thread_.join();
+    }
+
+    TimerService(const TimerService&)            = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    std::mutex                mutex_;
+    std::vector<TimerClient*> clients_;
+    std::atomic<bool>         running_;
+    std::thread               thread_;
+};
+
+#endif // TIMER_SERVICE_HPP
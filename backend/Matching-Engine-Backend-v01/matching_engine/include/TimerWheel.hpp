@@ -0,0 +1,107 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "Order.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TimerWheel — hierarchical timing wheel of order expiries.
+//
+//  Time is counted in integer ticks.  Level 0 has one slot per tick for the
+//  next 64 ticks; each level above covers 64× the span of the one below with
+//  the same 64 slots, so five levels reach 64^5 ticks ahead.  When the wheel
+//  crosses a slot boundary of level L, that slot's entries are re-filed one
+//  level down ("cascaded"); an entry is therefore moved at most LEVELS - 1
+//  times before it fires, and advancing one tick touches only the slots that
+//  are due — never the orders that are not.
+//
+//  Deletion is lazy: cancels and fills do not touch the wheel.  An entry
+//  holds only the OrderId, and the owner checks on firing whether that order
+//  is still resting (IDs are never reused, so a stale entry cannot match a
+//  newer order).
+//
+//  Not thread-safe: owned and guarded by the OrderBook.
+// ─────────────────────────────────────────────────────────────────────────────
+class TimerWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS     = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS    = 5;
+
+    // `now` is the first tick advance() will process.
+    explicit TimerWheel(uint64_t now) : current_(now) {}
+
+    // Fire `id` at tick `due` (on the next advance if `due` has passed).
+    void schedule(OrderId id, uint64_t due) {
+        file(Entry{id, due < current_ ? current_ : due});
+        ++size_;
+    }
+
+    // Process every tick up to and including `now`, calling fire(OrderId)
+    // for each due entry.  `fire` must not call schedule().
+    template <typename Fn>
+    void advance(uint64_t now, Fn&& fire) {
+        if (size_ == 0) {
+            if (now >= current_) current_ = now + 1;
+            return;
+        }
+        for (; current_ <= now; ++current_) {
+            // Higher levels first, so entries can fall through several levels
+            // on the same tick.
+            for (unsigned level = LEVELS - 1; level > 0; --level) {
+                if (current_ & ((uint64_t(1) << (level * SLOT_BITS)) - 1)) continue;
+                cascade(level, slotIndex(current_, level));
+            }
+            std::vector<Entry>& due = slots_[0][current_ & (SLOTS - 1)];
+            if (due.empty()) continue;
+            scratch_.swap(due);
+            size_ -= scratch_.size();
+            for (const Entry& e : scratch_) fire(e.id);
+            scratch_.clear();
+        }
+    }
+
+    size_t   size()    const { return size_; }   // includes stale entries
+    uint64_t current() const { return current_; }
+
+private:
+    struct Entry {
+        OrderId  id;
+        uint64_t due;
+    };
+
+    static size_t slotIndex(uint64_t tick, unsigned level) {
+        return static_cast<size_t>(tick >> (level * SLOT_BITS)) & (SLOTS - 1);
+    }
+
+    // Place `e` on the lowest level whose span still reaches its due tick.
+    void file(const Entry& e) {
+        const uint64_t delta = e.due - current_;
+        unsigned level = 0;
+        while (level + 1 < LEVELS && delta >= (uint64_t(1) << ((level + 1) * SLOT_BITS)))
+            ++level;
+        // Beyond the top level's span: park in the furthest top-level slot;
+        // the entry is re-filed from its real due tick when that slot cascades.
+        const uint64_t reach = (uint64_t(1) << (LEVELS * SLOT_BITS)) - 1;
+        const uint64_t at    = delta > reach ? current_ + reach : e.due;
+        slots_[level][slotIndex(at, level)].push_back(e);
+    }
+
+    void cascade(unsigned level, size_t slot) {
+        std::vector<Entry>& bucket = slots_[level][slot];
+        if (bucket.empty()) return;
+        cascadeScratch_.swap(bucket);
+        for (const Entry& e : cascadeScratch_) file(e);
+        cascadeScratch_.clear();
+    }
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots_;
+    std::vector<Entry> scratch_;          // level-0 slot being fired
+    std::vector<Entry> cascadeScratch_;   // slot being re-filed
+    uint64_t           current_;          // next tick to process
+    size_t             size_ = 0;
+};
+
+#endif // TIMER_WHEEL_HPP
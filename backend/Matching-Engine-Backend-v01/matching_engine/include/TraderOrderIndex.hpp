@@ -0,0 +1,64 @@
+#ifndef TRADER_ORDER_INDEX_HPP
+#define TRADER_ORDER_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+#include "OrderPool.hpp"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TraderOrderIndex — every resting order of one book, listed per trader.
+//
+//  One head slot per TraderIndex (interned indices are dense, so a flat
+//  array) and an intrusive doubly-linked list threaded through the orders'
+//  OrderDetails by pool handle: linking and unlinking are O(1) and allocate
+//  nothing once the trader has a slot, and walking a trader's orders touches
+//  only that trader's orders.  The links live in the cold record so the
+//  64-byte Order the matching loop walks is unchanged.
+//
+//  Orders with no trader (INVALID_TRADER) are not listed.  Not thread-safe:
+//  owned and guarded by the OrderBook, alongside OrderIndex.
+// ─────────────────────────────────────────────────────────────────────────────
+class TraderOrderIndex {
+public:
+    void link(OrderPool& pool, OrderHandle handle) {
+        const TraderIndex trader = pool[handle].getTrader();
+        if (trader == INVALID_TRADER) return;
+        if (trader >= heads_.size()) heads_.resize(trader + 1, INVALID_ORDER_HANDLE);
+        OrderDetails& details = pool.details(handle);
+        details.prevOfTrader_ = INVALID_ORDER_HANDLE;
+        details.nextOfTrader_ = heads_[trader];
+        if (heads_[trader] != INVALID_ORDER_HANDLE)
+            pool.details(heads_[trader]).prevOfTrader_ = handle;
+        heads_[trader] = handle;
+    }
+
+    void unlink(OrderPool& pool, OrderHandle handle) {
+        const TraderIndex trader = pool[handle].getTrader();
+        if (trader == INVALID_TRADER) return;
+        OrderDetails& details = pool.details(handle);
+        if (details.prevOfTrader_ != INVALID_ORDER_HANDLE)
+            pool.details(details.prevOfTrader_).nextOfTrader_ = details.nextOfTrader_;
+        else
+            heads_[trader] = details.nextOfTrader_;
+        if (details.nextOfTrader_ != INVALID_ORDER_HANDLE)
+            pool.details(details.nextOfTrader_).prevOfTrader_ = details.prevOfTrader_;
+        details.prevOfTrader_ = details.nextOfTrader_ = INVALID_ORDER_HANDLE;
+    }
+
+    // Calls fn(OrderHandle) for each of `trader`'s orders, most recent first.
+    // fn may unlink (cancel) the order it is given, but no other.
+    template <typename Fn>
+    void forEach(const OrderPool& pool, TraderIndex trader, Fn&& fn) const {
+        if (trader >= heads_.size()) return;
+        for (OrderHandle handle = heads_[trader]; handle != INVALID_ORDER_HANDLE;) {
+            const OrderHandle next = pool.details(handle).nextOfTrader_;
+            fn(handle);
+            handle = next;
+        }
+    }
+
+private:
+    std::vector<OrderHandle> heads_;   // by TraderIndex; INVALID_ORDER_HANDLE = none
+};
+
+#endif // TRADER_ORDER_INDEX_HPP
@@ -0,0 +1,111 @@
+#ifndef TRADER_REGISTRY_HPP
+#define TRADER_REGISTRY_HPP
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdio>
+
+// Dense index of an interned trader ID (see TraderRegistry).
+using TraderIndex = uint32_t;
+static constexpr TraderIndex INVALID_TRADER = UINT32_MAX;
+
+// ILP tag values may not contain space, comma or '='.
+inline std::string sanitizeIlpTag(const std::string& val) {
+    std::string out = val;
+    for (char& c : out) {
+        if (c == ' ' || c == ',' || c == '=') c = '_';
+    }
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TraderRegistry — process-wide interning of trader ID strings.
+//
+//  intern() maps a trader ID to a small dense index once (mock traders and
+//  the TUI user do it at start-up); orders and trades then carry the 4-byte
+//  index.  Everything the logger needs per trader — the sanitized ILP tag and
+//  the device fingerprint — is computed once at intern() time, so no order,
+//  fill or log row hashes or copies a trader string.
+//
+//  Entries live in fixed-size chunks that are never moved or freed, so the
+//  lookups are lock-free: an index is only ever obtained from intern(), which has
+//  already published the entry it refers to.
+// ─────────────────────────────────────────────────────────────────────────────
+class TraderRegistry {
+public:
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNKS = 64;   // 65 536 traders
+
+    static TraderRegistry& getInstance() {
+        static TraderRegistry instance;
+        return instance;
+    }
+
+    TraderIndex intern(const std::string& traderId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = indexByName_.find(traderId);
+        if (it != indexByName_.end()) return it->second;
+
+        const TraderIndex index = static_cast<TraderIndex>(count_);
+        const size_t chunk = count_ / CHUNK_SIZE;
+        if (chunk >= MAX_CHUNKS)
+            throw std::runtime_error("TraderRegistry full");
+        if (!chunks_[chunk]) chunks_[chunk].reset(new Entry[CHUNK_SIZE]);
+        Entry& entry     = chunks_[chunk][count_ % CHUNK_SIZE];
+        entry.name       = traderId;
+        entry.tag        = sanitizeIlpTag(traderId);
+        entry.deviceHash = computeDeviceIdHash(traderId);
+        ++count_;
+        indexByName_.emplace(traderId, index);
+        return index;
+    }
+
+    const std::string& name(TraderIndex index)       const { return entry(index).name; }
+    const std::string& tag(TraderIndex index)        const { return entry(index).tag; }
+    const std::string& deviceHash(TraderIndex index) const { return entry(index).deviceHash; }
+
+    // ILP tag, or "NA" for INVALID_TRADER (no counterparty yet).
+    const std::string& tagOrNA(TraderIndex index) const {
+        static const std::string na = "NA";
+        return index == INVALID_TRADER ? na : tag(index);
+    }
+
+    // Deterministic FNV-1a device fingerprint: 8 upper-case hex digits.
+    static std::string computeDeviceIdHash(const std::string& traderId) {
+        uint32_t hash = 2166136261u; // FNV-1a offset basis
+        for (unsigned char c : traderId) {
+            hash ^= c;
+            hash *= 16777619u; // FNV prime
+        }
+        char buf[9];
+        std::snprintf(buf, sizeof(buf), "%08X", hash);
+        return std::string(buf);
+    }
+
+private:
+    struct Entry {
+        std::string name;        // as interned
+        std::string tag;         // sanitized for ILP tag columns
+        std::string deviceHash;  // computeDeviceIdHash(name)
+    };
+
+    const Entry& entry(TraderIndex index) const {
+        return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+    }
+
+    TraderRegistry() = default;
+    TraderRegistry(const TraderRegistry&)            = delete;
+    TraderRegistry& operator=(const TraderRegistry&) = delete;
+
+    std::mutex                                                mutex_;
+    std::unordered_map<std::string, TraderIndex>              indexByName_;
+    std::array<std::unique_ptr<Entry[]>, MAX_CHUNKS>          chunks_;
+    size_t                                                    count_ = 0;
+};
+
+#endif // TRADER_REGISTRY_HPP
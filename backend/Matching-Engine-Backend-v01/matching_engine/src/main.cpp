@@ -9,6 +9,7 @@
 #include <sstream>
 #include <map>
 #include <set>
+#include <optional>
 #include <atomic>
 #include <fstream>
 #include <csignal>
@@ -55,6 +56,7 @@ static char _getch() {
 #endif
 // ─────────────────────────────────────────────────────────────────────────────
 #include "OrderBook.hpp"
+#include "MatchingPool.hpp"
 #include "Logger.hpp"
 #include "MarketDisplay.hpp"
 #include "Instrument.hpp"
@@ -88,6 +90,34 @@ static void signalHandler(int /*sig*/) {
     g_shutdown.store(true);
 }
 
+// ME_BOOK_TYPE=ladder switches every OrderBook to the flat price ladder
+// (PriceLadder.hpp); anything else keeps DEFAULT_BOOK_TYPE.  Lets both level
+// containers be benchmarked against the same mock-trader order flow.
+static BookType bookTypeFromEnv() {
+    const char* v = std::getenv("ME_BOOK_TYPE");
+    if (v && std::string(v) == "ladder") return BookType::LADDER;
+    if (v && std::string(v) == "map")    return BookType::MAP;
+    return DEFAULT_BOOK_TYPE;
+}
+
+// ME_EXECUTION=dedicated gives every OrderBook its own matching thread fed by
+// a lock-free command ring; ME_EXECUTION=pooled shares ME_MATCHING_WORKERS
+// workers (default: one per core) between all books; ME_EXECUTION=locked (or
+// unset) keeps DEFAULT_EXECUTION_MODE.
+static ExecutionMode executionModeFromEnv() {
+    const char* v = std::getenv("ME_EXECUTION");
+    if (v && std::string(v) == "dedicated") return ExecutionMode::DEDICATED;
+    if (v && std::string(v) == "pooled")    return ExecutionMode::POOLED;
+    if (v && std::string(v) == "locked")    return ExecutionMode::LOCKED;
+    return DEFAULT_EXECUTION_MODE;
+}
+
+static unsigned matchingWorkersFromEnv() {
+    const char* v = std::getenv("ME_MATCHING_WORKERS");
+    int n = v ? std::atoi(v) : 0;
+    return n > 0 ? static_cast<unsigned>(n) : MatchingPool::defaultWorkerCount();
+}
+
 // Thread-safe User ID Generator
 // User IDs for real users start from 10001 (mock traders use 1-10000)
 // Uses atomic counter and timestamp to ensure uniqueness even with concurrent access
@@ -174,6 +204,13 @@ private:
     mutable std::mutex mutex_;
 };
 
+// Snapshot of one of the user's orders, copied out of the book by the
+// order listener (hot matching record + cold details).
+struct UserOrder {
+    Order        order;
+    OrderDetails details;
+};
+
 // Structure to track user's active trades/positions
 struct UserTrade {
     std::string orderId;
@@ -216,8 +253,8 @@ class TradingApplication {
         }
         for (const auto& trade : trades) {
             std::stringstream ss;
-            ss << "BuyOrderID: " << trade.getBuyOrderId()
-               << " | SellOrderID: " << trade.getSellOrderId()
+            ss << "BuyOrderID: " << formatOrderId(trade.getBuyOrderId())
+               << " | SellOrderID: " << formatOrderId(trade.getSellOrderId())
                << " | Price: $" << std::fixed << std::setprecision(2) << trade.getPrice()
                << " | Qty: " << trade.getQuantity();
             std::time_t t = std::chrono::system_clock::to_time_t(trade.getTimestamp());
@@ -230,13 +267,24 @@ public:
         : logger_("127.0.0.1", 9009)
         , userTradeCount_(0)
         , userId_(UserIdGenerator::getInstance().generateUserId())
+        , userTrader_(TraderRegistry::getInstance().intern(userId_))
         , totalBalance_(5000000.0)
         , totalRealizedPnL_(0.0)
     {
         // Create order books for each instrument, passing &logger_ so every
         // matched trade is sent to QuestDB in addition to order events.
+        const BookType      bookType      = bookTypeFromEnv();
+        const ExecutionMode executionMode = executionModeFromEnv();
+        if (executionMode == ExecutionMode::POOLED)
+            matchingPool_ = std::make_unique<MatchingPool>(matchingWorkersFromEnv());
         for (const auto& instrument : InstrumentManager::getInstance().getInstruments()) {
-            orderBooks_[instrument.instrumentId] = std::make_shared<OrderBook>(&logger_);
+            orderBooks_[instrument.instrumentId] =
+                std::make_shared<OrderBook>(instrument.instrumentId, &logger_, bookType, executionMode);
+            if (matchingPool_) matchingPool_->attach(*orderBooks_[instrument.instrumentId]);
+            orderBooks_[instrument.instrumentId]->setOrderListener(
+                [this](const Order& order, const OrderDetails& details) {
+                    onUserOrderEvent(order, details);
+                });
             marketDisplays_[instrument.instrumentId] = std::make_shared<MarketDisplay>(orderBooks_[instrument.instrumentId]);
         }
         // No static price range is set; all prices are determined by real order flow.
@@ -256,10 +304,12 @@ public:
             auto ob = orderBooks_[instrument.instrumentId];
             for (int i = 0; i < 20; ++i) {
                 mockTraders_.emplace_back(
-                    std::make_unique<MockTrader>(ob, instrument.instrumentId, &logger_));
+                    std::make_unique<MockTrader>(ob, instrument.instrumentId));
                 mockTraders_.back()->start();
             }
+            if (MARKET_MAKER_ACTIVE) MarketMakerDesk::instance().addBook(ob);
         }
+        MarketMakerDesk::instance().start();   // no-op unless MARKET_MAKER_ACTIVE
 
         // Main trading loop
         running_ = true;
@@ -303,6 +353,10 @@ public:
                     case 'J':
                         handleExitAllTrades();
                         break;
+                    case 'k':
+                    case 'K':
+                        handleCancelAllOrders();
+                        break;
                     case 'e':
                         running_ = false;
                         break;
@@ -312,7 +366,8 @@ public:
         }
         running_ = false;
 
-        // Stop all mock traders
+        // Stop the market-maker desk and all mock traders
+        MarketMakerDesk::instance().stop();
         for (auto& trader : mockTraders_)
             trader->stop();
         mockTraders_.clear();
@@ -329,9 +384,8 @@ public:
 private:
 
         void displayOrderBookTable(std::shared_ptr<OrderBook> orderBook, double marketPrice) {
-            // Gather buy and sell levels
-            const auto& buyLevels = orderBook->getBuyLevels();
-            const auto& sellLevels = orderBook->getSellLevels();
+            // Gather buy and sell levels from the book's published snapshot
+            const BookSnapshot depth = orderBook->getDepthSnapshot();
 
             std::cout << "\nOrder Book (Top 5 Levels)\n";
             std::cout << "+-------------------------------------------------------------+\n";
@@ -343,19 +397,18 @@ private:
             std::vector<std::pair<std::string, std::string>> buyRows;  // qty, price
             std::vector<std::pair<std::string, std::string>> sellRows; // price, qty
 
-            size_t count = 0;
-            for (auto it = buyLevels.begin(); it != buyLevels.end() && count < 5; ++it, ++count) {
-                double price = it->first;
-                size_t qty = it->second->getTotalQuantity();
+            const Instrument& instrument = orderBook->getInstrument();
+            for (size_t i = 0; i < depth.bidCount && i < 5; ++i) {
+                double price = instrument.toPrice(depth.bids[i].price);
+                size_t qty = depth.bids[i].quantity;
                 std::stringstream priceStream;
                 priceStream << std::fixed << std::setprecision(2) << price;
                 buyRows.emplace_back(std::to_string(qty), priceStream.str());
                 totalBuyQty += qty;
             }
-            count = 0;
-            for (auto it = sellLevels.begin(); it != sellLevels.end() && count < 5; ++it, ++count) {
-                double price = it->first;
-                size_t qty = it->second->getTotalQuantity();
+            for (size_t i = 0; i < depth.askCount && i < 5; ++i) {
+                double price = instrument.toPrice(depth.asks[i].price);
+                size_t qty = depth.asks[i].quantity;
                 std::stringstream priceStream;
                 priceStream << std::fixed << std::setprecision(2) << price;
                 sellRows.emplace_back(priceStream.str(), std::to_string(qty));
@@ -796,25 +849,28 @@ private:
             }
         }
 
+        // Snap to the instrument's tick grid — the book only holds whole ticks.
+        const Instrument& instrument = orderBooks_[currentInstrumentId_]->getInstrument();
+        const Price priceTicks = instrument.toTicks(price);
+        price = instrument.toPrice(priceTicks);
+
         // Calculate net amount and check balance
         double netAmount = price * quantity;
         if (!checkAndPromptBalance(netAmount)) {
             return;
         }
 
-        auto order = std::make_shared<Order>(
+        // The book logs the order and reports it back through
+        // onUserOrderEvent(), which records it in userOrders_.
+        OrderAck ack = orderBooks_[currentInstrumentId_]->addOrder(OrderRequest{
             type == 1 ? OrderType::MARKET : OrderType::LIMIT,
             OrderSide::BUY,
-            price,
+            priceTicks,
             quantity,
             TimeInForce::GTC,
-            userId_, // Use actual user ID
+            userTrader_, // Use actual user ID
             currentInstrumentId_
-        );
-
-        orderBooks_[currentInstrumentId_]->addOrder(order);
-        logger_.logOrder(*order);
-        userOrders_.push_back(order);
+        });
 
         // Deduct from balance
         totalBalance_ -= netAmount;
@@ -822,11 +878,11 @@ private:
         // Add to active trades for tracking
         {
             std::lock_guard<std::mutex> lock(tradesMutex_);
-            userActiveTrades_.emplace_back(order->getOrderId(), currentInstrumentId_, OrderSide::BUY, quantity, price);
+            userActiveTrades_.emplace_back(formatOrderId(ack.orderId), currentInstrumentId_, OrderSide::BUY, quantity, price);
         }
 
         std::stringstream ss;
-        ss << "BUY Order placed - ID: " << order->getOrderId() 
+        ss << "BUY Order placed - ID: " << formatOrderId(ack.orderId) 
            << " | Type: " << (type == 1 ? "MARKET" : "LIMIT")
            << " | Quantity: " << quantity
            << " | Net Amount: Rs." << std::fixed << std::setprecision(2) << netAmount;
@@ -862,25 +918,28 @@ private:
             }
         }
 
+        // Snap to the instrument's tick grid — the book only holds whole ticks.
+        const Instrument& instrument = orderBooks_[currentInstrumentId_]->getInstrument();
+        const Price priceTicks = instrument.toTicks(price);
+        price = instrument.toPrice(priceTicks);
+
         // Calculate net amount and check balance
         double netAmount = price * quantity;
         if (!checkAndPromptBalance(netAmount)) {
             return;
         }
 
-        auto order = std::make_shared<Order>(
+        // The book logs the order and reports it back through
+        // onUserOrderEvent(), which records it in userOrders_.
+        OrderAck ack = orderBooks_[currentInstrumentId_]->addOrder(OrderRequest{
             type == 1 ? OrderType::MARKET : OrderType::LIMIT,
             OrderSide::SELL,
-            price,
+            priceTicks,
             quantity,
             TimeInForce::GTC,
-            userId_, // Use actual user ID
+            userTrader_, // Use actual user ID
             currentInstrumentId_
-        );
-
-        orderBooks_[currentInstrumentId_]->addOrder(order);
-        logger_.logOrder(*order);
-        userOrders_.push_back(order);
+        });
 
         // Deduct from balance
         totalBalance_ -= netAmount;
@@ -888,11 +947,11 @@ private:
         // Add to active trades for tracking
         {
             std::lock_guard<std::mutex> lock(tradesMutex_);
-            userActiveTrades_.emplace_back(order->getOrderId(), currentInstrumentId_, OrderSide::SELL, quantity, price);
+            userActiveTrades_.emplace_back(formatOrderId(ack.orderId), currentInstrumentId_, OrderSide::SELL, quantity, price);
         }
 
         std::stringstream ss;
-        ss << "SELL Order placed - ID: " << order->getOrderId() 
+        ss << "SELL Order placed - ID: " << formatOrderId(ack.orderId) 
            << " | Type: " << (type == 1 ? "MARKET" : "LIMIT")
            << " | Quantity: " << quantity
            << " | Net Amount: Rs." << std::fixed << std::setprecision(2) << netAmount;
@@ -906,22 +965,28 @@ private:
 
     void viewUserOrders() {
         addToHistory("=== Your Orders ===");
-        if (userOrders_.empty()) {
+        std::vector<UserOrder> orders;
+        {
+            std::lock_guard<std::mutex> lock(userOrdersMutex_);
+            orders = userOrders_;
+        }
+        if (orders.empty()) {
             addToHistory("No orders found.");
             return;
         }
 
-        for (const auto& order : userOrders_) {
+        for (const auto& userOrder : orders) {
+            const Order& order = userOrder.order;
             std::stringstream ss;
-            ss << "ID: " << order->getOrderId() 
-               << " | Type: " << (order->getType() == OrderType::LIMIT ? "LIMIT" : "MARKET")
-               << " | Side: " << (order->getSide() == OrderSide::BUY ? "BUY" : "SELL")
-               << " | Price: $" << std::fixed << std::setprecision(2) << order->getPrice()
-               << " | Qty: " << order->getQuantity()
-               << " | Remaining: " << order->getRemainingQuantity()
+            ss << "ID: " << formatOrderId(order.getOrderId()) 
+               << " | Type: " << orderTypeName(order.getType())
+               << " | Side: " << (order.getSide() == OrderSide::BUY ? "BUY" : "SELL")
+               << " | Price: $" << std::fixed << std::setprecision(2) << order.getPrice()
+               << " | Qty: " << userOrder.details.getQuantity()
+               << " | Remaining: " << order.getRemainingQuantity()
                << " | Status: ";
             
-            switch (order->getStatus()) {
+            switch (order.getStatus()) {
                 case OrderStatus::NEW: ss << "NEW"; break;
                 case OrderStatus::PARTIALLY_FILLED: ss << "PARTIAL"; break;
                 case OrderStatus::FILLED: ss << "FILLED"; break;
@@ -938,19 +1003,16 @@ private:
         std::string orderId;
         std::cin >> orderId;
 
-        auto it = std::find_if(userOrders_.begin(), userOrders_.end(),
-            [&orderId](const std::shared_ptr<Order>& order) {
-                return order->getOrderId() == orderId;
-            });
+        std::optional<UserOrder> userOrder = findUserOrder(orderId);
 
-        if (it != userOrders_.end()) {
-            auto order = *it;
+        if (userOrder) {
+            const Order* order = &userOrder->order;
             std::stringstream ss;
             ss << "Order Details - ID: " << orderId << "\n"
-               << "Type: " << (order->getType() == OrderType::LIMIT ? "LIMIT" : "MARKET") << "\n"
+               << "Type: " << orderTypeName(order->getType()) << "\n"
                << "Side: " << (order->getSide() == OrderSide::BUY ? "BUY" : "SELL") << "\n"
                << "Price: $" << std::fixed << std::setprecision(2) << order->getPrice() << "\n"
-               << "Original Quantity: " << order->getQuantity() << "\n"
+               << "Original Quantity: " << userOrder->details.getQuantity() << "\n"
                << "Remaining Quantity: " << order->getRemainingQuantity() << "\n"
                << "Status: ";
             
@@ -967,6 +1029,30 @@ private:
         }
     }
 
+    // Engine-wide mass cancel: every resting order of `trader`, optionally
+    // only in one instrument and/or on one side.  Each book walks just that
+    // trader's orders (OrderBook::massCancel), so this is the cancel-on-
+    // disconnect path as well.  Returns how many orders were cancelled.
+    size_t massCancel(TraderIndex trader, std::optional<int> instrumentId = std::nullopt,
+                      std::optional<OrderSide> side = std::nullopt) {
+        size_t cancelled = 0;
+        for (const auto& entry : orderBooks_) {
+            if (instrumentId && entry.first != *instrumentId) continue;
+            if (entry.second) cancelled += entry.second->massCancel(trader, side);
+        }
+        return cancelled;
+    }
+
+    // Handle cancel all orders - mass cancel of every resting user order
+    void handleCancelAllOrders() {
+        addToHistory("=== Cancel All Orders ===");
+        // The books log each CANCELLED event and update userOrders_ through
+        // onUserOrderEvent().
+        size_t cancelled = massCancel(userTrader_);
+        addToHistory("Orders cancelled: " + std::to_string(cancelled));
+        std::cout << "\n" << cancelled << " order(s) cancelled. Press Enter to return to menu..."; std::cin.ignore(); std::cin.get();
+    }
+
     // Handle order cancellation
     void handleCancelOrder() {
         try {
@@ -974,21 +1060,13 @@ private:
             addToHistory("Enter Order ID:");
             std::string orderId;
             std::cin >> orderId;
-            auto it = std::find_if(userOrders_.begin(), userOrders_.end(),
-                [&orderId](const std::shared_ptr<Order>& order) {
-                    return order && order->getOrderId() == orderId;
-                });
-            if (it == userOrders_.end() || !(*it)) {
+            std::optional<UserOrder> userOrder = findUserOrder(orderId);
+            if (!userOrder) {
                 addToHistory("Order not found: " + orderId);
                 std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
                 return;
             }
-            auto order = *it;
-            if (!order) {
-                addToHistory("Order pointer is null.");
-                std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
-                return;
-            }
+            const Order* order = &userOrder->order;
             if (order->getStatus() == OrderStatus::CANCELLED) {
                 addToHistory("Order is already cancelled.");
                 std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
@@ -1000,7 +1078,7 @@ private:
                 return;
             }
             // Check for valid quantity
-            if (order->getQuantity() <= 0) {
+            if (userOrder->details.getQuantity() <= 0) {
                 addToHistory("Order quantity is zero or negative. Cannot cancel.");
                 std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
                 return;
@@ -1013,18 +1091,15 @@ private:
                 std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
                 return;
             } else if (choice == 2) {
+                // The book logs the CANCELLED event and updates userOrders_
+                // through onUserOrderEvent().
                 auto orderBookIt = orderBooks_.find(order->getInstrumentId());
-                if (orderBookIt != orderBooks_.end() && orderBookIt->second) {
-                    orderBookIt->second->cancelOrder(orderId);
-                } else {
-                    order->cancel();
-                }
-                for (auto& uo : userOrders_) {
-                    if (uo && uo->getOrderId() == orderId) {
-                        uo->cancel();
-                    }
+                if (orderBookIt == orderBooks_.end() || !orderBookIt->second ||
+                    !orderBookIt->second->cancelOrder(order->getOrderId())) {
+                    addToHistory("Order is no longer resting in the book: " + orderId);
+                    std::cout << "\nPress Enter to return to menu..."; std::cin.ignore(); std::cin.get();
+                    return;
                 }
-                logger_.logOrder(*order);
                 addToHistory("Order cancelled: " + orderId);
                 std::cout << "\nOrder cancelled successfully. Press Enter to return to menu..."; std::cin.ignore(); std::cin.get();
                 return;
@@ -1188,6 +1263,7 @@ private:
             std::cout << "| h. Exit Trade        |\n";
             std::cout << "| i. Withdraw Balance  |\n";
             std::cout << "| j. Exit All Trades   |\n";
+            std::cout << "| k. Cancel All Orders |\n";
             std::cout << "+----------------------+\n";
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
         }
@@ -1358,6 +1434,32 @@ private:
         return total;
     }
 
+    /**
+     * OrderBook listener: runs under the book mutex for every order event.
+     * Keeps a snapshot of each of this user's orders in userOrders_.
+     */
+    void onUserOrderEvent(const Order& order, const OrderDetails& details) {
+        if (order.getTrader() != userTrader_) return;
+        std::lock_guard<std::mutex> lock(userOrdersMutex_);
+        for (auto& existing : userOrders_) {
+            if (existing.order.getOrderId() == order.getOrderId()) {
+                existing = UserOrder{order, details};
+                return;
+            }
+        }
+        userOrders_.push_back(UserOrder{order, details});
+    }
+
+    // Look up a snapshot by the "<instrumentId>-<sequence>" form shown to the user.
+    std::optional<UserOrder> findUserOrder(const std::string& text) {
+        OrderId orderId;
+        if (!parseOrderId(text, orderId)) return std::nullopt;
+        std::lock_guard<std::mutex> lock(userOrdersMutex_);
+        for (const auto& userOrder : userOrders_)
+            if (userOrder.order.getOrderId() == orderId) return userOrder;
+        return std::nullopt;
+    }
+
     /**
      * Called from the main loop every 100 ms.
      * Finds user orders that the OrderBook expiry thread has marked as EXPIRED,
@@ -1365,17 +1467,26 @@ private:
      * Expired orders are already logged to QuestDB by the OrderBook's expiry thread.
      */
     void processExpiredUserOrders() {
-        for (auto& order : userOrders_) {
-            if (!order) continue;
-            if (order->getStatus() != OrderStatus::EXPIRED) continue;
-            const std::string& oid = order->getOrderId();
-            // Skip if already handled
-            if (handledExpiredOrders_.count(oid)) continue;
-            handledExpiredOrders_.insert(oid);
+        // Snapshot newly expired orders first so no other lock is taken while
+        // userOrdersMutex_ is held (book listeners acquire it under the book mutex).
+        std::vector<Order> expired;
+        {
+            std::lock_guard<std::mutex> lock(userOrdersMutex_);
+            for (const auto& userOrder : userOrders_) {
+                const Order& order = userOrder.order;
+                if (order.getStatus() != OrderStatus::EXPIRED) continue;
+                // Skip if already handled
+                if (!handledExpiredOrders_.insert(order.getOrderId()).second) continue;
+                expired.push_back(order);
+            }
+        }
+
+        for (const auto& order : expired) {
+            const std::string oid = formatOrderId(order.getOrderId());
 
             // Refund the unfilled portion of the balance
-            double refund = order->getPrice() *
-                            static_cast<double>(order->getRemainingQuantity());
+            double refund = order.getPrice() *
+                            static_cast<double>(order.getRemainingQuantity());
             totalBalance_ += refund;
 
             // Mark the UserTrade as inactive so it disappears from active list
@@ -1397,10 +1508,15 @@ private:
         }
     }
 
+    std::unique_ptr<MatchingPool> matchingPool_;   // POOLED mode only; outlives the books
     std::map<int, std::shared_ptr<OrderBook>> orderBooks_;
     std::map<int, std::shared_ptr<MarketDisplay>> marketDisplays_;
     Logger logger_;
-    std::vector<std::shared_ptr<Order>> userOrders_;
+    // Snapshots of this user's orders, kept current by onUserOrderEvent().
+    // The live Order objects belong to each book's pool and are recycled once
+    // terminal, so the UI never holds pointers into a book.
+    std::vector<UserOrder> userOrders_;
+    std::mutex userOrdersMutex_;
     std::atomic<bool> running_{false};
     std::thread displayThread_;
     std::atomic<int> userTradeCount_;
@@ -1410,12 +1526,13 @@ private:
     
     // User account management
     std::string userId_;
+    TraderIndex userTrader_;   // userId_ interned once; carried on every order
     double totalBalance_;
     double totalRealizedPnL_;
     std::vector<UserTrade> userActiveTrades_;
     std::vector<ClosedTrade> userTradeHistory_;
     mutable std::mutex tradesMutex_;
-    std::set<std::string> handledExpiredOrders_; // order IDs already processed for expiry
+    std::set<OrderId> handledExpiredOrders_; // order IDs already processed for expiry
     // ── Book HTTP server (port 9100) ──────────────────────────────────────────
     std::thread         bookServerThread_;
     std::atomic<bool>   bookServerRunning_{false};
@@ -1424,29 +1541,108 @@ private:
     std::vector<std::unique_ptr<MockTrader>> mockTraders_;
 
     // Build a JSON string for the top-5 bid/ask levels of one instrument.
-    // Reads directly from the in-memory OrderBook — same source as the terminal display.
+    // Reads the book's published depth snapshot — same source as the terminal display.
     std::string buildBookJson(int instrId) const {
         auto it = orderBooks_.find(instrId);
         if (it == orderBooks_.end()) return "null";
         const auto& ob = it->second;
-        const auto& buyLevels  = ob->getBuyLevels();
-        const auto& sellLevels = ob->getSellLevels();
+        const BookSnapshot depth = ob->getDepthSnapshot();
 
         std::ostringstream j;
         j << std::fixed << std::setprecision(2);
+        const Instrument& instrument = ob->getInstrument();
         j << "{\"bids\":[";
-        int cnt = 0;
-        for (auto li = buyLevels.begin(); li != buyLevels.end() && cnt < 5; ++li, ++cnt) {
-            if (cnt) j << ",";
-            j << "{\"price\":" << li->first
-              << ",\"qty_buyers\":" << li->second->getTotalQuantity() << "}";
+        for (size_t i = 0; i < depth.bidCount && i < 5; ++i) {
+            if (i) j << ",";
+            j << "{\"price\":" << instrument.toPrice(depth.bids[i].price)
+              << ",\"qty_buyers\":" << depth.bids[i].quantity << "}";
         }
         j << "],\"asks\":[";
-        cnt = 0;
-        for (auto li = sellLevels.begin(); li != sellLevels.end() && cnt < 5; ++li, ++cnt) {
-            if (cnt) j << ",";
-            j << "{\"price\":" << li->first
-              << ",\"qty_sellers\":" << li->second->getTotalQuantity() << "}";
+        for (size_t i = 0; i < depth.askCount && i < 5; ++i) {
+            if (i) j << ",";
+            j << "{\"price\":" << instrument.toPrice(depth.asks[i].price)
+              << ",\"qty_sellers\":" << depth.asks[i].quantity << "}";
+        }
+        j << "],\"seq\":" << depth.feedSequence << "}";
+        return j.str();
+    }
+
+    // Incremental L2 events for one instrument after feed sequence `since`
+    // (as returned in "seq" by /book/<id> or the previous /feed call).  If the
+    // book's journal no longer reaches back that far the reply is
+    // {"reset":true} and the client re-fetches /book/<id>.
+    std::string buildFeedJson(int instrId, uint64_t since) const {
+        auto it = orderBooks_.find(instrId);
+        if (it == orderBooks_.end()) return "null";
+        const auto& ob = it->second;
+
+        std::vector<MarketDataEvent> events;
+        if (!ob->getMarketDataFeed().readSince(since, events, MARKET_DATA_FEED_PAGE))
+            return "{\"reset\":true}";
+
+        std::ostringstream j;
+        j << std::fixed << std::setprecision(2);
+        const Instrument& instrument = ob->getInstrument();
+        j << "{\"reset\":false,\"seq\":" << (events.empty() ? since : events.back().sequence)
+          << ",\"events\":[";
+        for (size_t i = 0; i < events.size(); ++i) {
+            const MarketDataEvent& e = events[i];
+            if (i) j << ",";
+            j << "{\"seq\":" << e.sequence
+              << ",\"type\":\"" << (e.kind == MarketDataEvent::LEVEL ? "level" : "trade") << "\""
+              << ",\"side\":\"" << (e.side == OrderSide::BUY ? "BUY" : "SELL") << "\""
+              << ",\"price\":" << instrument.toPrice(e.price)
+              << ",\"qty\":" << e.quantity;
+            if (e.kind == MarketDataEvent::LEVEL) j << ",\"orders\":" << e.orderCount;
+            else j << ",\"trade_id\":\"" << formatTradeId(instrId, e.tradeSequence) << "\"";
+            j << "}";
+        }
+        j << "]}";
+        return j.str();
+    }
+
+    // Order-by-order (L3) events after `since`.  With since=0, or once the
+    // journal no longer reaches back that far, the reply is instead a full
+    // image: {"reset":true,"seq":S,"orders":[...]} — apply it, then poll
+    // from S.
+    std::string buildOrderFeedJson(int instrId, uint64_t since) const {
+        auto it = orderBooks_.find(instrId);
+        if (it == orderBooks_.end()) return "null";
+        const auto& ob = it->second;
+
+        std::ostringstream j;
+        j << std::fixed << std::setprecision(2);
+        const Instrument& instrument = ob->getInstrument();
+        auto writeEvent = [&](const MarketDataEvent& e) {
+            static const char* const kinds[] = {"level", "trade", "add", "execute", "delete", "amend"};
+            j << "{\"seq\":" << e.sequence
+              << ",\"type\":\"" << kinds[e.kind] << "\""
+              << ",\"order_id\":\"" << formatOrderId(e.orderId) << "\""
+              << ",\"side\":\"" << (e.side == OrderSide::BUY ? "BUY" : "SELL") << "\""
+              << ",\"price\":" << instrument.toPrice(e.price)
+              << ",\"qty\":" << e.quantity;
+            if (e.kind == MarketDataEvent::ORDER_EXECUTE)
+                j << ",\"trade_id\":\"" << formatTradeId(instrId, e.tradeSequence) << "\"";
+            j << "}";
+        };
+
+        std::vector<MarketDataEvent> events;
+        if (since == 0 || !ob->getOrderFeed().readSince(since, events, MARKET_DATA_FEED_PAGE)) {
+            const OrderBookImage image = ob->getOrderBookImage();
+            j << "{\"reset\":true,\"seq\":" << image.sequence << ",\"orders\":[";
+            for (size_t i = 0; i < image.orders.size(); ++i) {
+                if (i) j << ",";
+                writeEvent(image.orders[i]);
+            }
+            j << "]}";
+            return j.str();
+        }
+
+        j << "{\"reset\":false,\"seq\":" << (events.empty() ? since : events.back().sequence)
+          << ",\"events\":[";
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (i) j << ",";
+            writeEvent(events[i]);
         }
         j << "]}";
         return j.str();
@@ -1457,7 +1653,10 @@ private:
     // Routes handled:
     //   GET /book/<id>   → JSON for one instrument (id = 1..15)
     //   GET /books       → JSON object: { "1": {...}, "2": {...}, ... }
+    //   GET /feed/<id>?since=<seq> → L2 events after <seq> (see buildFeedJson)
+    //   GET /l3/<id>?since=<seq>   → L3 events after <seq> (see buildOrderFeedJson)
     void serveBookHttp() {
+        ThreadTuning::getInstance().pin(ThreadRole::HTTP);
         int srv = ::socket(AF_INET, SOCK_STREAM, 0);
         if (srv < 0) return;
         int opt = 1;
@@ -1500,6 +1699,17 @@ private:
                     first = false;
                 }
                 body += "}";
+            } else if (req.find("GET /feed/") != std::string::npos ||
+                       req.find("GET /l3/") != std::string::npos) {
+                // Route: GET /feed/<id>?since=<seq>  |  GET /l3/<id>?since=<seq>
+                const bool l3 = req.find("GET /l3/") != std::string::npos;
+                auto pos = req.find(l3 ? "GET /l3/" : "GET /feed/");
+                int id = std::atoi(req.c_str() + pos + (l3 ? 8 : 10));
+                auto sincePos = req.find("since=");
+                uint64_t since = 0;
+                if (sincePos != std::string::npos && sincePos < req.find(" HTTP/"))
+                    since = std::strtoull(req.c_str() + sincePos + 6, nullptr, 10);
+                body = l3 ? buildOrderFeedJson(id, since) : buildFeedJson(id, since);
             } else {
                 // Route: GET /book/<id>
                 auto pos = req.find("GET /book/");
@@ -76,7 +76,23 @@ elif [ main.cpp -nt matching_engine ] || \
      [ ../include/Instrument.hpp -nt matching_engine ] || \
      [ ../include/MarketDisplay.hpp -nt matching_engine ] || \
      [ ../include/PriceLevel.hpp -nt matching_engine ] || \
-     [ ../include/Trade.hpp -nt matching_engine ]; then
+     [ ../include/Trade.hpp -nt matching_engine ] || \
+     [ ../include/BookSide.hpp -nt matching_engine ] || \
+     [ ../include/PriceLadder.hpp -nt matching_engine ] || \
+     [ ../include/OrderPool.hpp -nt matching_engine ] || \
+     [ ../include/TraderRegistry.hpp -nt matching_engine ] || \
+     [ ../include/OrderIndex.hpp -nt matching_engine ] || \
+     [ ../include/OccupancyBitmap.hpp -nt matching_engine ] || \
+     [ ../include/TimerWheel.hpp -nt matching_engine ] || \
+     [ ../include/TimerService.hpp -nt matching_engine ] || \
+     [ ../include/MpscRing.hpp -nt matching_engine ] || \
+     [ ../include/MatchingPool.hpp -nt matching_engine ] || \
+     [ ../include/ThreadTuning.hpp -nt matching_engine ] || \
+     [ ../include/BookSnapshot.hpp -nt matching_engine ] || \
+     [ ../include/DepthCache.hpp -nt matching_engine ] || \
+     [ ../include/MarketDataFeed.hpp -nt matching_engine ] || \
+     [ ../include/TraderOrderIndex.hpp -nt matching_engine ] || \
+     [ ../include/StopBook.hpp -nt matching_engine ]; then
     NEEDS_BUILD=1
     echo "=== Source changed — rebuilding matching engine ==="
 fi